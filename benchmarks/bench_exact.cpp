@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include "algorithms/subgraph_algorithm.h"
+#include "bench_graphs.h"
+
+using namespace Subgraphs;
+using SubgraphsBench::IndexType;
+using SubgraphsBench::randomGraph;
+
+// Phase 1 of the exact algorithm. Args: k = |V_P|, N = |V_G|
+static void BM_GetAllMissingEdges(benchmark::State& state) {
+    auto P = randomGraph(state.range(0), 50, 1);
+    auto G = randomGraph(state.range(1), 30, 2);
+    for (auto _ : state) {
+        auto missingEdges = SubgraphAlgorithm<IndexType>::getAllMissingEdges(P, G);
+        benchmark::DoNotOptimize(missingEdges);
+    }
+    // Embeddings evaluated per iteration: k! permutations × C(N, k) subsets
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(P.permutationsCount() *
+                                                 G.combinationsCount(P.getVertexCount())));
+}
+BENCHMARK(BM_GetAllMissingEdges)
+    ->ArgNames({"k", "N"})
+    ->ArgsProduct({{3, 4, 5}, {8, 12, 16}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Phase 2 of the exact algorithm on a precomputed Phase 1 table. Args: k, N, n copies
+static void BM_FindMinimalExtension(benchmark::State& state) {
+    auto P = randomGraph(state.range(0), 50, 1);
+    auto G = randomGraph(state.range(1), 30, 2);
+    const int copies = static_cast<int>(state.range(2));
+    const auto missingEdges = SubgraphAlgorithm<IndexType>::getAllMissingEdges(P, G);
+    ExactSearchStats stats;
+    for (auto _ : state) {
+        auto extension = SubgraphAlgorithm<IndexType>::findMinimalExtension(
+            copies, P, G, missingEdges, ExactOptions{}, SubgraphAlgorithm<IndexType>::Clock::now(),
+            stats);
+        benchmark::DoNotOptimize(extension);
+    }
+    state.counters["nodes"] = static_cast<double>(stats.nodesExplored);
+    state.counters["cost"] = static_cast<double>(stats.cost);
+}
+BENCHMARK(BM_FindMinimalExtension)
+    ->ArgNames({"k", "N", "n"})
+    ->Args({3, 6, 2})
+    ->Args({3, 8, 2})
+    ->Args({3, 6, 3})
+    ->Args({4, 7, 2})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,46 @@
+#include <filesystem>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_graphs.h"
+#include "utils/graph_loader.h"
+
+using namespace Subgraphs;
+using SubgraphsBench::IndexType;
+using SubgraphsBench::randomGraph;
+
+enum class FileFormat { TEXT, EDGES, BINARY };
+
+// GraphLoader::loadFromFile on a pattern of 8 vertices and a target of N vertices with the
+// given density, written once in the given format. Args: N, density in percent
+static void BM_LoadGraphFile(benchmark::State& state, FileFormat format) {
+    const auto P = randomGraph(8, 50, 1);
+    const auto G = randomGraph(state.range(0), state.range(1), 2);
+    const auto path = std::filesystem::temp_directory_path() /
+                      ("subgraphs_bench_" + std::to_string(static_cast<int>(format)) + "_" +
+                       std::to_string(state.range(0)) + "_" + std::to_string(state.range(1)));
+    if (format == FileFormat::TEXT) {
+        GraphLoader<IndexType>::saveToFile(P, G, {}, 0, path);
+    } else if (format == FileFormat::EDGES) {
+        GraphLoader<IndexType>::saveToEdgeListFile(P, G, path);
+    } else {
+        GraphLoader<IndexType>::saveToBinaryFile(P, G, path);
+    }
+
+    for (auto _ : state) {
+        auto graphs = GraphLoader<IndexType>::loadFromFile(path);
+        benchmark::DoNotOptimize(graphs);
+    }
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(std::filesystem::file_size(path)));
+    std::filesystem::remove(path);
+}
+#define LOAD_GRAPH_BENCHMARK(name, format)                                                        \
+    BENCHMARK_CAPTURE(BM_LoadGraphFile, name, format)                                             \
+        ->ArgNames({"N", "density"})                                                              \
+        ->ArgsProduct({{64, 512, 2048}, {5, 50}})                                                 \
+        ->Unit(benchmark::kMicrosecond)
+LOAD_GRAPH_BENCHMARK(text, FileFormat::TEXT);
+LOAD_GRAPH_BENCHMARK(edges, FileFormat::EDGES);
+LOAD_GRAPH_BENCHMARK(binary, FileFormat::BINARY);
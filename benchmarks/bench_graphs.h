@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "graph/multigraph.h"
+
+namespace SubgraphsBench {
+
+// Index type of the CLI (GRAPH_INDEX_TYPE in main.cpp), so the kernels are measured as shipped
+using IndexType = uint16_t;
+
+// Random multigraph on `vertices` vertices: each ordered pair (i != j) gets an edge with
+// probability densityPercent / 100, with multiplicity 1-3. Fixed seeds keep runs comparable.
+inline Subgraphs::Multigraph<IndexType> randomGraph(int64_t vertices, int64_t densityPercent,
+                                                    uint32_t seed = 1) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> multiplicity(1, 3);
+    const size_t n = static_cast<size_t>(vertices);
+    std::vector<std::vector<uint8_t>> matrix(n, std::vector<uint8_t>(n, 0));
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (i != j && percent(generator) < densityPercent) {
+                matrix[i][j] = static_cast<uint8_t>(multiplicity(generator));
+            }
+        }
+    }
+    return Subgraphs::Multigraph<IndexType>(std::move(matrix));
+}
+
+} // namespace SubgraphsBench
@@ -0,0 +1,70 @@
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Hungarian.h"
+#include "algorithms/heuristic.h"
+#include "bench_graphs.h"
+
+using namespace Subgraphs;
+using SubgraphsBench::IndexType;
+using SubgraphsBench::randomGraph;
+
+// One createWeightMatrix_* heuristic for the subset {0, ..., k-1}. Args: k, N
+static void BM_WeightMatrix(benchmark::State& state, HeuristicType heuristic) {
+    auto P = randomGraph(state.range(0), 50, 1);
+    auto G = randomGraph(state.range(1), 30, 2);
+    std::vector<IndexType> subset(static_cast<size_t>(state.range(0)));
+    std::iota(subset.begin(), subset.end(), IndexType{0});
+    for (auto _ : state) {
+        auto matrix = Heuristic<IndexType>::createWeightMatrix(P, G, subset, heuristic);
+        benchmark::DoNotOptimize(matrix);
+    }
+}
+#define WEIGHT_MATRIX_BENCHMARK(name, heuristic)                                                  \
+    BENCHMARK_CAPTURE(BM_WeightMatrix, name, heuristic)                                           \
+        ->ArgNames({"k", "N"})                                                                    \
+        ->ArgsProduct({{4, 8, 16}, {64, 256}})                                                    \
+        ->Unit(benchmark::kMicrosecond)
+WEIGHT_MATRIX_BENCHMARK(degree, HeuristicType::DEGREE_DIFFERENCE);
+WEIGHT_MATRIX_BENCHMARK(directed, HeuristicType::DIRECTED_DEGREE);
+WEIGHT_MATRIX_BENCHMARK(directed_ignore, HeuristicType::DIRECTED_DEGREE_IGNORE_SURPLUS);
+WEIGHT_MATRIX_BENCHMARK(histogram, HeuristicType::NEIGHBOR_HISTOGRAM);
+WEIGHT_MATRIX_BENCHMARK(structure, HeuristicType::STRUCTURE_MATCHING);
+WEIGHT_MATRIX_BENCHMARK(greedy, HeuristicType::GREEDY_NEIGHBOR);
+
+// HungarianAlgorithm::Solve on a random k×k cost matrix. Args: k
+static void BM_HungarianSolve(benchmark::State& state) {
+    const size_t k = static_cast<size_t>(state.range(0));
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> cost(0.0, 100.0);
+    std::vector<std::vector<double>> costs(k, std::vector<double>(k));
+    for (auto& row : costs) {
+        for (double& value : row) {
+            value = cost(generator);
+        }
+    }
+    HungarianAlgorithm hungarian;
+    std::vector<int> assignment;
+    for (auto _ : state) {
+        // Solve does not modify the matrix, but takes it by non-const reference
+        double total = hungarian.Solve(costs, assignment);
+        benchmark::DoNotOptimize(total);
+    }
+}
+BENCHMARK(BM_HungarianSolve)->ArgName("k")->RangeMultiplier(2)->Range(4, 128);
+
+// multiplyAdjacency (A², used by the structure heuristic). Args: N, density in percent
+static void BM_MultiplyAdjacency(benchmark::State& state) {
+    const auto adjacency = randomGraph(state.range(0), state.range(1), 4).getAdjacencyMatrix();
+    for (auto _ : state) {
+        auto square = multiplyAdjacency<IndexType>(adjacency, adjacency);
+        benchmark::DoNotOptimize(square);
+    }
+}
+BENCHMARK(BM_MultiplyAdjacency)
+    ->ArgNames({"N", "density"})
+    ->ArgsProduct({{16, 64, 256}, {10, 50}})
+    ->Unit(benchmark::kMicrosecond);
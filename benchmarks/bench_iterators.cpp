@@ -0,0 +1,55 @@
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_graphs.h"
+#include "graph/combination_iterator.h"
+#include "graph/permutation_iterator.h"
+#include "graph/sequence_iterator.h"
+
+using namespace Subgraphs;
+using SubgraphsBench::IndexType;
+
+// Full enumeration of the k! permutations of k elements. Args: k
+static void BM_PermutationRange(benchmark::State& state) {
+    const auto k = static_cast<IndexType>(state.range(0));
+    int64_t count = 0;
+    for (auto _ : state) {
+        for (const auto& permutation : PermutationRange<IndexType>(k)) {
+            benchmark::DoNotOptimize(permutation.data());
+            ++count;
+        }
+    }
+    state.SetItemsProcessed(count);
+}
+BENCHMARK(BM_PermutationRange)->ArgName("k")->DenseRange(4, 8, 2);
+
+// Full enumeration of the C(N, k) k-subsets of N elements. Args: N, k
+static void BM_CombinationRange(benchmark::State& state) {
+    const auto n = static_cast<IndexType>(state.range(0));
+    const auto k = static_cast<IndexType>(state.range(1));
+    int64_t count = 0;
+    for (auto _ : state) {
+        for (const auto& combination : CombinationRange<IndexType>(n, k)) {
+            benchmark::DoNotOptimize(combination.data());
+            ++count;
+        }
+    }
+    state.SetItemsProcessed(count);
+}
+BENCHMARK(BM_CombinationRange)->ArgNames({"N", "k"})->ArgsProduct({{16, 24}, {3, 5}});
+
+// Full enumeration of the maxValue^length sequences. Args: maxValue, length
+static void BM_SequenceRange(benchmark::State& state) {
+    const auto maxValue = static_cast<IndexType>(state.range(0));
+    const auto length = static_cast<IndexType>(state.range(1));
+    int64_t count = 0;
+    for (auto _ : state) {
+        for (const auto& sequence : SequenceRange<IndexType>(maxValue, length)) {
+            benchmark::DoNotOptimize(sequence.data());
+            ++count;
+        }
+    }
+    state.SetItemsProcessed(count);
+}
+BENCHMARK(BM_SequenceRange)->ArgNames({"max", "length"})->ArgsProduct({{6, 24}, {2, 3}});
@@ -0,0 +1,38 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "perf_counters.h"
+
+// Same as BENCHMARK_MAIN, but reports JSON unless --benchmark_format is given, so the output
+// can be stored and compared between commits (e.g. with Google Benchmark's compare.py)
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+    bool hasFormat = false;
+    for (int i = 1; i < argc; ++i) {
+        hasFormat = hasFormat || std::string(argv[i]).rfind("--benchmark_format", 0) == 0;
+    }
+    std::string jsonFormat = "--benchmark_format=json";
+    if (!hasFormat) {
+        args.insert(args.begin() + 1, jsonFormat.data());
+    }
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    // The *Phases benchmarks report hardware counters when the system allows them, and only
+    // their phase times otherwise; the JSON context records which one it was
+    SubgraphsBench::PerfCounters probe;
+    benchmark::AddCustomContext("perf_counters",
+                                probe.available() ? "available" : probe.unavailableReason());
+    if (!probe.available()) {
+        std::cerr << "Hardware counters unavailable (" << probe.unavailableReason()
+                  << "), phase benchmarks report times only" << std::endl;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Hungarian.h"
+#include "algorithms/subgraph_algorithm.h"
+#include "bench_graphs.h"
+#include "perf_counters.h"
+
+using namespace Subgraphs;
+using SubgraphsBench::IndexType;
+using SubgraphsBench::PerfCounters;
+using SubgraphsBench::randomGraph;
+
+// Solvers split into their phases, each with its own hardware counters (see PerfCounters).
+// A high miss count per instruction points at memory-bound phases, a high IPC at
+// compute-bound ones.
+
+// Exact algorithm: Phase 1 table and Phase 2 search. Args: k = |V_P|, N = |V_G|, n copies
+static void BM_ExactPhases(benchmark::State& state) {
+    auto P = randomGraph(state.range(0), 50, 1);
+    auto G = randomGraph(state.range(1), 30, 2);
+    const int copies = static_cast<int>(state.range(2));
+    PerfCounters counters;
+    ExactSearchStats stats;
+    for (auto _ : state) {
+        std::vector<std::vector<std::vector<Edge<IndexType>>>> missingEdges;
+        {
+            auto phase = counters.measure("phase1");
+            missingEdges = SubgraphAlgorithm<IndexType>::getAllMissingEdges(P, G);
+        }
+        auto phase = counters.measure("phase2");
+        auto extension = SubgraphAlgorithm<IndexType>::findMinimalExtension(
+            copies, P, G, missingEdges, ExactOptions{}, SubgraphAlgorithm<IndexType>::Clock::now(),
+            stats);
+        benchmark::DoNotOptimize(extension);
+    }
+    counters.report(state);
+}
+BENCHMARK(BM_ExactPhases)
+    ->ArgNames({"k", "N", "n"})
+    ->Args({3, 8, 2})
+    ->Args({4, 7, 2})
+    ->Args({4, 10, 1})
+    ->Unit(benchmark::kMillisecond);
+
+// approx2's per-copy work: weight matrix for the next k-subset, then the assignment.
+// Args: k, N, n copies
+static void BM_Approx2Phases(benchmark::State& state, HeuristicType heuristic) {
+    auto P = randomGraph(state.range(0), 50, 1);
+    auto G = randomGraph(state.range(1), 30, 2);
+    const int copies = static_cast<int>(state.range(2));
+    PerfCounters counters;
+    HungarianAlgorithm hungarian;
+    std::vector<int> assignment;
+    for (auto _ : state) {
+        int copy = 0;
+        for (const auto& subset : G.combinations(P.getVertexCount())) {
+            if (copy++ == copies) {
+                break;
+            }
+            std::vector<std::vector<double>> weights;
+            {
+                auto phase = counters.measure("weight_matrix");
+                weights = Heuristic<IndexType>::createWeightMatrix(P, G, subset, heuristic);
+            }
+            auto phase = counters.measure("hungarian");
+            double total = hungarian.Solve(weights, assignment);
+            benchmark::DoNotOptimize(total);
+        }
+    }
+    counters.report(state);
+}
+#define APPROX2_PHASES_BENCHMARK(name, heuristic)                                                 \
+    BENCHMARK_CAPTURE(BM_Approx2Phases, name, heuristic)                                          \
+        ->ArgNames({"k", "N", "n"})                                                               \
+        ->Args({8, 64, 4})                                                                        \
+        ->Args({16, 256, 4})                                                                      \
+        ->Unit(benchmark::kMicrosecond)
+APPROX2_PHASES_BENCHMARK(degree, HeuristicType::DEGREE_DIFFERENCE);
+APPROX2_PHASES_BENCHMARK(structure, HeuristicType::STRUCTURE_MATCHING);
+
+// approx1 as a whole; its seed evaluation runs on a worker pool, whose threads are counted
+// too. Args: k, N, n copies
+static void BM_Approx1Phases(benchmark::State& state) {
+    auto P = randomGraph(state.range(0), 50, 1);
+    auto G = randomGraph(state.range(1), 30, 2);
+    const int copies = static_cast<int>(state.range(2));
+    PerfCounters counters;
+    for (auto _ : state) {
+        auto phase = counters.measure("approx1");
+        auto extension = SubgraphAlgorithm<IndexType>::run_approx_v1(copies, P, G);
+        benchmark::DoNotOptimize(extension);
+    }
+    counters.report(state);
+}
+BENCHMARK(BM_Approx1Phases)
+    ->ArgNames({"k", "N", "n"})
+    ->Args({8, 64, 4})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,156 @@
+#include "perf_counters.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace SubgraphsBench {
+
+namespace {
+
+constexpr const char* EVENT_NAMES[PerfCounters::EVENT_COUNT] = {
+    "cycles", "instructions", "L1D_misses", "LLC_misses", "branch_misses"};
+
+#ifdef __linux__
+
+struct EventConfig {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cacheReadMiss(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr EventConfig EVENT_CONFIGS[PerfCounters::EVENT_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int openEvent(const EventConfig& event) {
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = event.type;
+    attributes.config = event.config;
+    // Only user space, so it works with perf_event_paranoid = 2
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    // Threads started later (the solvers' worker pools) count too
+    attributes.inherit = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+
+#endif
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    descriptors.fill(-1);
+#ifdef __linux__
+    int lastError = 0;
+    for (int event = 0; event < EVENT_COUNT; ++event) {
+        descriptors[event] = openEvent(EVENT_CONFIGS[event]);
+        if (descriptors[event] >= 0) {
+            ioctl(descriptors[event], PERF_EVENT_IOC_RESET, 0);
+            ioctl(descriptors[event], PERF_EVENT_IOC_ENABLE, 0);
+            ++openedCount;
+        } else {
+            lastError = errno;
+        }
+    }
+    if (openedCount == 0) {
+        reason = std::string("perf_event_open failed: ") + std::strerror(lastError);
+    }
+#else
+    reason = "hardware counters need Linux perf_event_open";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int descriptor : descriptors) {
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+    }
+#endif
+}
+
+std::array<double, PerfCounters::EVENT_COUNT> PerfCounters::read() const {
+    std::array<double, EVENT_COUNT> values{};
+#ifdef __linux__
+    for (int event = 0; event < EVENT_COUNT; ++event) {
+        // value, time enabled, time running
+        uint64_t data[3] = {0, 0, 0};
+        if (descriptors[event] < 0 ||
+            ::read(descriptors[event], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+            continue;
+        }
+        // More events than hardware counters: the kernel time-shares them, so extrapolate
+        values[event] = data[2] > 0 && data[2] < data[1]
+                            ? static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+                                  static_cast<double>(data[2])
+                            : static_cast<double>(data[0]);
+    }
+#endif
+    return values;
+}
+
+PerfCounters::Phase::Phase(PerfCounters& owner, const char* phaseName)
+    : counters(owner), name(phaseName), begin(owner.read()),
+      start(std::chrono::steady_clock::now()) {}
+
+PerfCounters::Phase::~Phase() {
+    const auto end = std::chrono::steady_clock::now();
+    const auto values = counters.read();
+    const auto counts = allocations.counts(); // Before the phase map allocates
+    Totals& totals = counters.phases[name];
+    for (int event = 0; event < EVENT_COUNT; ++event) {
+        totals.events[event] += values[event] - begin[event];
+    }
+    totals.milliseconds += std::chrono::duration<double, std::milli>(end - start).count();
+    totals.allocations.allocations += counts.allocations;
+    totals.allocations.bytes += counts.bytes;
+    totals.allocations.peakBytes = std::max(totals.allocations.peakBytes, counts.peakBytes);
+}
+
+void PerfCounters::report(benchmark::State& state) const {
+    for (const auto& [phase, totals] : phases) {
+        state.counters[phase + ".ms"] =
+            benchmark::Counter(totals.milliseconds, benchmark::Counter::kAvgIterations);
+        for (int event = 0; event < EVENT_COUNT; ++event) {
+            if (descriptors[event] >= 0) {
+                state.counters[phase + "." + EVENT_NAMES[event]] =
+                    benchmark::Counter(totals.events[event], benchmark::Counter::kAvgIterations);
+            }
+        }
+        if (Subgraphs::AllocationTracker::hooksInstalled()) {
+            state.counters[phase + ".allocs"] =
+                benchmark::Counter(static_cast<double>(totals.allocations.allocations),
+                                   benchmark::Counter::kAvgIterations);
+            state.counters[phase + ".alloc_bytes"] =
+                benchmark::Counter(static_cast<double>(totals.allocations.bytes),
+                                   benchmark::Counter::kAvgIterations);
+            state.counters[phase + ".peak_bytes"] =
+                static_cast<double>(totals.allocations.peakBytes);
+        }
+        if (descriptors[CYCLES] >= 0 && descriptors[INSTRUCTIONS] >= 0 &&
+            totals.events[CYCLES] > 0.0) {
+            state.counters[phase + ".IPC"] = totals.events[INSTRUCTIONS] / totals.events[CYCLES];
+        }
+    }
+}
+
+} // namespace SubgraphsBench
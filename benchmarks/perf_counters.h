@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "utils/allocation_tracker.h"
+
+namespace SubgraphsBench {
+
+/**
+ * Hardware Performance Counters per Solver Phase
+ *
+ * Opens Linux perf_event_open counters for the calling thread (and the threads it starts
+ * afterwards, e.g. ThreadPool workers) and attributes their deltas to named phases:
+ *
+ *     PerfCounters counters;
+ *     for (auto _ : state) {
+ *         { auto phase = counters.measure("phase1"); ... }
+ *         { auto phase = counters.measure("phase2"); ... }
+ *     }
+ *     counters.report(state);
+ *
+ * report() adds per-iteration averages such as phase1.cycles, phase1.IPC or
+ * phase2.LLC_misses to the benchmark, next to phase1.ms. Events the CPU, the kernel
+ * (perf_event_paranoid) or the container do not allow are skipped one by one; with none
+ * available only the phase times are reported.
+ *
+ * In subgraphs_bench_alloc, which links the allocation hooks, phases also report
+ * <phase>.allocs, <phase>.alloc_bytes and <phase>.peak_bytes (see AllocationTracker).
+ */
+class PerfCounters {
+  public:
+    enum Event { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, EVENT_COUNT };
+
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // True if at least one hardware event could be opened
+    bool available() const { return openedCount > 0; }
+    // Why no event could be opened (empty when available)
+    const std::string& unavailableReason() const { return reason; }
+
+    // Adds the counter deltas and the wall time of its lifetime to phase `name`
+    class Phase {
+      public:
+        Phase(PerfCounters& owner, const char* phaseName);
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+        ~Phase();
+
+      private:
+        PerfCounters& counters;
+        const char* name;
+        std::array<double, EVENT_COUNT> begin;
+        std::chrono::steady_clock::time_point start;
+        Subgraphs::AllocationScope allocations;
+    };
+    Phase measure(const char* phaseName) { return Phase(*this, phaseName); }
+
+    // Adds "<phase>.<event>" counters, averaged over the benchmark's iterations
+    void report(benchmark::State& state) const;
+
+  private:
+    struct Totals {
+        std::array<double, EVENT_COUNT> events{};
+        double milliseconds = 0.0;
+        Subgraphs::AllocationCounts allocations; // peakBytes is the maximum over the runs
+    };
+
+    // Current counts, scaled up if the kernel multiplexed the event; 0 for closed events
+    std::array<double, EVENT_COUNT> read() const;
+
+    std::array<int, EVENT_COUNT> descriptors;
+    int openedCount = 0;
+    std::string reason;
+    std::map<std::string, Totals> phases;
+};
+
+} // namespace SubgraphsBench
@@ -0,0 +1,350 @@
+// Scaling and quality driver: the scenarios of tests/performance_tests/matrix_gen.py,
+// generated and solved in-process, written in the CSV schema of plot_results.py.
+//
+// Usage: subgraphs_scaling [--output file] [--seed s] [--sets name,name,...] [--repeat r]
+//                          [--exact-time-limit seconds]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "algorithms/subgraph_algorithm.h"
+#include "graph/multigraph.h"
+
+using namespace Subgraphs;
+
+namespace {
+
+// Index type of the CLI (GRAPH_INDEX_TYPE in main.cpp)
+using IndexType = uint16_t;
+
+// One pattern/target pair of a graph set, as in matrix_gen.py
+struct GraphConfig {
+    int pattern;
+    int target;
+    bool patternSparse = false;
+    bool targetSparse = false;
+    double patternDensity = 0.5;
+    double targetDensity = 0.5;
+};
+
+struct GraphSet {
+    std::string name;
+    bool withExact;                 // exact_* sets also run the exact algorithm
+    std::vector<int> subgraphCounts; // Copies to test; {1} except for the *_subgraph_var sets
+    std::vector<GraphConfig> configs;
+};
+
+std::vector<GraphConfig> scaled(const std::vector<std::pair<int, int>>& sizes, bool patternSparse,
+                                bool targetSparse, double patternDensity,
+                                double targetDensity) {
+    std::vector<GraphConfig> configs;
+    for (const auto& [pattern, target] : sizes) {
+        configs.push_back(
+            {pattern, target, patternSparse, targetSparse, patternDensity, targetDensity});
+    }
+    return configs;
+}
+
+std::vector<GraphSet> scenarioSets() {
+    const std::vector<std::pair<int, int>> approxSizes = {
+        {5, 15}, {10, 30}, {15, 45}, {20, 60}, {25, 75},
+        {30, 90}, {35, 105}, {40, 120}, {45, 135}, {50, 150}};
+    const std::vector<std::pair<int, int>> mixedSizes = {
+        {5, 15}, {8, 24}, {10, 30}, {12, 36}, {15, 45},
+        {18, 54}, {20, 60}, {22, 66}, {25, 75}, {30, 90}};
+    const std::vector<std::pair<int, int>> exactSizes = {{1, 4}, {2, 8}, {3, 12}, {4, 16}, {5, 20}};
+
+    return {
+        {"approx_dense", false, {1}, scaled(approxSizes, false, false, 0.5, 0.5)},
+        {"approx_sparse", false, {1}, scaled(approxSizes, true, true, 0.15, 0.15)},
+        {"approx_sparse_dense", false, {1}, scaled(mixedSizes, true, false, 0.15, 0.5)},
+        {"approx_dense_sparse", false, {1}, scaled(mixedSizes, false, true, 0.5, 0.15)},
+        {"approx_subgraph_var", false, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10},
+         scaled({{10, 60}}, false, false, 0.5, 0.5)},
+        {"exact_dense", true, {1}, scaled(exactSizes, false, false, 0.5, 0.5)},
+        {"exact_sparse", true, {1}, scaled(exactSizes, true, true, 0.3, 0.3)},
+        {"exact_sparse_dense", true, {1}, scaled(exactSizes, true, false, 0.3, 0.5)},
+        {"exact_dense_sparse", true, {1}, scaled(exactSizes, false, true, 0.5, 0.3)},
+        {"exact_subgraph_var", true, {1, 2, 3, 4, 5}, scaled({{4, 8}}, false, false, 0.5, 0.5)},
+    };
+}
+
+// matrix_gen.py's get_value: dense entries are uniform in 0..20, sparse entries are 1..20
+// with probability `density` and 0 otherwise; the diagonal is 0
+Multigraph<IndexType> scenarioGraph(int vertices, bool sparse, double density,
+                                    std::mt19937& generator) {
+    std::uniform_int_distribution<int> denseValue(0, 20);
+    std::uniform_int_distribution<int> sparseValue(1, 20);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    const size_t n = static_cast<size_t>(vertices);
+    std::vector<std::vector<uint8_t>> matrix(n, std::vector<uint8_t>(n, 0));
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (i == j) {
+                continue;
+            }
+            int value = 0;
+            if (!sparse) {
+                value = denseValue(generator);
+            } else if (coin(generator) < density) {
+                value = sparseValue(generator);
+            }
+            matrix[i][j] = static_cast<uint8_t>(value);
+        }
+    }
+    return Multigraph<IndexType>(std::move(matrix));
+}
+
+// Peak resident set size of the process in KiB (VmHWM), if the system reports it
+std::optional<uint64_t> peakResidentKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stoull(line.substr(6));
+        }
+    }
+    return std::nullopt;
+}
+
+// Lowers the peak to the current resident size, so the next peak belongs to the next run
+bool resetPeakResident() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    return static_cast<bool>(clearRefs.flush());
+}
+
+struct Measurement {
+    double milliseconds = 0.0;
+    std::string status = "success";
+    uint64_t cost = 0;
+    std::optional<uint64_t> memoryKb; // Peak resident growth during the run
+};
+
+struct Row {
+    std::string graphSet;
+    int patternSize;
+    int targetSize;
+    int subgraphs;
+    std::string algorithm;
+    std::string heuristic;
+    Measurement measurement;
+    std::optional<double> costRatio; // cost / exact cost
+};
+
+Measurement measure(AlgorithmType algorithm, HeuristicType heuristic, int subgraphs,
+                    Multigraph<IndexType>& P, Multigraph<IndexType>& G, int repeat,
+                    double exactTimeLimit) {
+    using Clock = std::chrono::steady_clock;
+    Measurement measurement;
+    std::vector<double> times;
+    for (int run = 0; run < repeat; ++run) {
+        const bool trackMemory = run == 0 && resetPeakResident();
+        const auto baseline = trackMemory ? peakResidentKb() : std::nullopt;
+        const auto start = Clock::now();
+        try {
+            std::vector<Edge<IndexType>> extension;
+            if (algorithm == AlgorithmType::EXACT) {
+                ExactOptions options;
+                options.timeLimitSeconds = exactTimeLimit;
+                ExactSearchStats stats;
+                extension = SubgraphAlgorithm<IndexType>::run_exact(subgraphs, P, G, options,
+                                                                    &stats);
+                if (!stats.optimal) {
+                    measurement.status = "timeout";
+                }
+            } else {
+                extension = SubgraphAlgorithm<IndexType>::run_algorithm(algorithm, subgraphs, P, G,
+                                                                        heuristic);
+            }
+            times.push_back(
+                std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            measurement.cost = SubgraphAlgorithm<IndexType>::extensionCost(extension);
+        } catch (const std::exception& e) {
+            std::cerr << "  " << algorithmName(algorithm) << ": " << e.what() << std::endl;
+            measurement.status = "error";
+            return measurement;
+        }
+        const auto peak = baseline ? peakResidentKb() : std::nullopt;
+        if (peak) {
+            measurement.memoryKb = *peak - std::min(*peak, *baseline);
+        }
+        if (measurement.status != "success") {
+            break; // A timed-out exact search is not repeated
+        }
+    }
+    // Median of the repetitions
+    std::sort(times.begin(), times.end());
+    measurement.milliseconds = times[times.size() / 2];
+    return measurement;
+}
+
+void writeCsv(std::ostream& out, const std::vector<Row>& rows) {
+    // The first eight columns are the schema of run_performance_tests.py / plot_results.py
+    out << "graph_set,pattern_size,target_size,num_subgraphs,algorithm,heuristic,"
+           "execution_time_ms,status,extension_cost,cost_ratio,peak_memory_kb\n";
+    out << std::setprecision(6);
+    for (const auto& row : rows) {
+        const Measurement& m = row.measurement;
+        out << row.graphSet << ',' << row.patternSize << ',' << row.targetSize << ','
+            << row.subgraphs << ',' << row.algorithm << ',' << row.heuristic << ',';
+        if (m.status != "error") {
+            out << m.milliseconds;
+        }
+        out << ',' << m.status << ',';
+        if (m.status != "error") {
+            out << m.cost;
+        }
+        out << ',';
+        if (row.costRatio) {
+            out << *row.costRatio;
+        }
+        out << ',';
+        if (m.memoryKb) {
+            out << *m.memoryKb;
+        }
+        out << '\n';
+    }
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string outputPath = "performance_results.csv";
+    uint32_t seed = 42;
+    std::vector<std::string> selectedSets;
+    int repeat = 1;
+    double exactTimeLimit = 180.0; // TIMEOUT_EXACT of run_performance_tests.py
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Usage: " << argv[0] << " [--output file] [--seed s] [--sets name,...] [--repeat r] [--exact-time-limit seconds]" << std::endl;
+            return 1;
+        }
+        const std::string value = argv[++i];
+        try {
+            if (arg == "--output") {
+                outputPath = value;
+            } else if (arg == "--seed") {
+                seed = static_cast<uint32_t>(std::stoul(value));
+            } else if (arg == "--sets") {
+                selectedSets = splitList(value);
+            } else if (arg == "--repeat") {
+                repeat = std::max(1, std::stoi(value));
+            } else if (arg == "--exact-time-limit") {
+                exactTimeLimit = std::stod(value);
+            } else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return 1;
+            }
+        } catch (...) {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return 1;
+        }
+    }
+
+    const auto sets = scenarioSets();
+    for (const auto& name : selectedSets) {
+        if (std::none_of(sets.begin(), sets.end(),
+                         [&](const GraphSet& set) { return set.name == name; })) {
+            std::cerr << "Unknown graph set: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Row> rows;
+    for (const auto& set : sets) {
+        // Every set draws from its own generator, so selecting sets does not change the graphs
+        std::seed_seq setSeed(set.name.begin(), set.name.end());
+        std::vector<uint32_t> setSeedValue(1);
+        setSeed.generate(setSeedValue.begin(), setSeedValue.end());
+        std::mt19937 generator(seed ^ setSeedValue[0]);
+        if (!selectedSets.empty() &&
+            std::find(selectedSets.begin(), selectedSets.end(), set.name) == selectedSets.end()) {
+            continue;
+        }
+        std::cerr << set.name << std::endl;
+
+        for (const auto& config : set.configs) {
+            auto P = scenarioGraph(config.pattern, config.patternSparse, config.patternDensity,
+                                   generator);
+            auto G = scenarioGraph(config.target, config.targetSparse, config.targetDensity,
+                                   generator);
+            for (int subgraphs : set.subgraphCounts) {
+                std::cerr << "  p" << config.pattern << " t" << config.target << " n" << subgraphs
+                          << std::endl;
+                auto addRow = [&](AlgorithmType algorithm, std::string heuristic,
+                                  Measurement measurement) {
+                    rows.push_back({set.name, config.pattern, config.target, subgraphs,
+                                    std::string(algorithmName(algorithm)), std::move(heuristic),
+                                    std::move(measurement), std::nullopt});
+                };
+
+                // Exact runs first; its optimum is the reference for the cost ratios
+                std::optional<uint64_t> optimum;
+                const size_t firstRow = rows.size();
+                if (set.withExact) {
+                    auto exact = measure(AlgorithmType::EXACT, HeuristicType::DEGREE_DIFFERENCE,
+                                         subgraphs, P, G, repeat, exactTimeLimit);
+                    if (exact.status == "success") {
+                        optimum = exact.cost;
+                    }
+                    addRow(AlgorithmType::EXACT, "", std::move(exact));
+                }
+                addRow(AlgorithmType::APPROX1, "",
+                       measure(AlgorithmType::APPROX1, HeuristicType::DEGREE_DIFFERENCE,
+                               subgraphs, P, G, repeat, exactTimeLimit));
+                for (HeuristicType heuristic : ALL_HEURISTICS) {
+                    addRow(AlgorithmType::APPROX2, std::string(heuristicName(heuristic)),
+                           measure(AlgorithmType::APPROX2, heuristic, subgraphs, P, G, repeat,
+                                   exactTimeLimit));
+                }
+                addRow(AlgorithmType::PORTFOLIO, "",
+                       measure(AlgorithmType::PORTFOLIO, HeuristicType::DEGREE_DIFFERENCE,
+                               subgraphs, P, G, repeat, exactTimeLimit));
+
+                if (optimum) {
+                    for (size_t row = firstRow; row < rows.size(); ++row) {
+                        const uint64_t cost = rows[row].measurement.cost;
+                        if (rows[row].measurement.status != "error" && (*optimum > 0 || cost == 0)) {
+                            rows[row].costRatio = *optimum > 0 ? static_cast<double>(cost) /
+                                                                     static_cast<double>(*optimum)
+                                                               : 1.0;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::ofstream out(outputPath, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Could not write results: " << outputPath << std::endl;
+        return 1;
+    }
+    writeCsv(out, rows);
+    std::cerr << rows.size() << " result(s) written to " << outputPath << std::endl;
+    return 0;
+}
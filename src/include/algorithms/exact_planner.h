@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "../graph/multigraph.h"
+
+namespace Subgraphs {
+
+/**
+ * Resource Estimate of the Exact Algorithm
+ *
+ * Computed from k = |V_P|, N = |V_G|, n and the edges of P and G before anything large is
+ * allocated, so an instance that would exhaust memory is rejected in milliseconds instead
+ * of being OOM-killed minutes into Phase 1.
+ *
+ * Phase 1 memory is close to exact: over all embeddings every ordered pair of P vertices is
+ * mapped uniformly onto the ordered pairs of G vertices, so the total number of missing
+ * edges follows from the histogram of G's multiplicities. The only slack is the allocator
+ * overhead, counted as 16 bytes per embedding. Phase 2 work is the worst case without any
+ * pruning; real searches usually visit a small fraction of it. Times are rough, from
+ * per-operation costs measured on a desktop CPU.
+ *
+ * The streaming search (MissingEdgeStorage::STREAMING) replaces the Phase 1 table with
+ * fixed tables of size O(k! × k² + C(N, k)) and a cache of rows of average size
+ * streamingRowBytes, at least one per copy. A spilled table (MissingEdgeStorage::SPILLED)
+ * takes spillFileBytes on disk; in memory only the writer's row and the search state count,
+ * because the mapped table lives in the reclaimable page cache. The compact table
+ * (MissingEdgeStorage::COMPACT) takes compactBytes, plus one decoded row per copy; its encoded
+ * lists are bounded above by compactEdgeBytes, which is what its constructor reserves.
+ */
+struct ExactPlan {
+    int copies{};                   // n
+    double combinations{};          // C(N, k)
+    uint64_t embeddings{};          // k! × C(N, k)
+    double combinationSets{};       // C(C(N, k), n)
+    double configurations{};        // combinationSets × (k!)^n
+    double missingEdges{};          // Edges stored by Phase 1, over all embeddings
+    uint64_t phase1Bytes{};         // Phase 1 table
+    uint64_t phase2Bytes{};         // Search state next to the table
+    double phase1Seconds{};         // Estimated
+    double phase2Seconds{};         // Estimated worst case (no pruning)
+    bool fitsIndexType{true};       // k! and C(N, k) are representable in the index type
+    uint64_t streamingRowBytes{};   // Missing edges of one vertex subset, on average
+    uint64_t streamingFixedBytes{}; // Permuted P, slot index and binomials of streaming
+    uint64_t spillFileBytes{};      // Scratch file of a spilled table
+    uint64_t compactEdgeBytes{};    // Encoded lists of the compact table (upper bound)
+    uint64_t compactBytes{};        // Whole compact table
+
+    // Saturates like the phase estimates
+    uint64_t peakBytes() const {
+        return phase1Bytes > UINT64_MAX - phase2Bytes ? UINT64_MAX : phase1Bytes + phase2Bytes;
+    }
+    // Peak of the streaming search with a cache of `cacheBytes`
+    uint64_t streamingPeakBytes(uint64_t cacheBytes) const;
+    // Peak outside the page cache with a spilled table
+    uint64_t spilledPeakBytes() const;
+    // Peak with the compact table and its cached rows
+    uint64_t compactPeakBytes() const;
+    void print(std::ostream& out) const;
+};
+
+template <typename IndexType>
+ExactPlan planExact(int n, const Multigraph<IndexType>& P, const Multigraph<IndexType>& G);
+
+// "512M", "4G", "1.5G", "100000" (bytes); K/M/G/T are powers of 1024. nullopt if invalid.
+inline std::optional<uint64_t> parseMemorySize(std::string_view text);
+// 1536 -> "1.5 KiB"
+inline std::string formatMemorySize(uint64_t bytes);
+
+} // namespace Subgraphs
+
+#include "exact_planner.inl"
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "../graph/edge.h"
+
+namespace Subgraphs {
+
+namespace PlannerCosts {
+// Phase 1: checking one vertex pair of one embedding, and building one edge list
+constexpr double PAIR_SECONDS = 5e-9;
+constexpr double EMBEDDING_SECONDS = 50e-9;
+// Phase 2: one search node (a permutation of one copy merged into the partial extension)
+constexpr double NODE_SECONDS = 30e-9;
+// malloc bookkeeping and rounding of one edge list
+constexpr uint64_t LIST_OVERHEAD_BYTES = 16;
+} // namespace PlannerCosts
+
+namespace PlannerDetail {
+
+// Saturates at the largest uint64_t instead of wrapping
+inline uint64_t toBytes(double bytes) {
+    return bytes >= 1.8e19 ? std::numeric_limits<uint64_t>::max()
+                           : static_cast<uint64_t>(std::ceil(bytes));
+}
+
+inline double choose(double n, double k) {
+    if (k < 0 || k > n) {
+        return 0.0;
+    }
+    double result = 1.0;
+    for (double i = 1; i <= k; ++i) {
+        result = result * (n - k + i) / i;
+    }
+    return std::round(result);
+}
+
+} // namespace PlannerDetail
+
+/**
+ * Plan the Exact Algorithm
+ *
+ * Every embedding is an injective map V_P -> V_G, and each one occurs exactly once among
+ * the k! × C(N, k) (permutation, combination) pairs. For a fixed pair of P vertices (a, b)
+ * with a != b the image (u, v) therefore runs through all ordered pairs of distinct G
+ * vertices equally often, and a loop (a, a) through all G vertices. With the histograms of
+ * G's off-diagonal and diagonal multiplicities, the number of missing edges that Phase 1
+ * stores is
+ *
+ *     embeddings × sum over (a, b) of the fraction of G cells with fewer edges than P(a, b)
+ *
+ * in O(N² + k²) time, without enumerating a single embedding.
+ */
+template <typename IndexType>
+ExactPlan planExact(int n, const Multigraph<IndexType>& P, const Multigraph<IndexType>& G) {
+    using namespace PlannerDetail;
+    ExactPlan plan;
+    plan.copies = n;
+    const double k = static_cast<double>(P.getVertexCount());
+    const double N = static_cast<double>(G.getVertexCount());
+
+    double permutations = 1.0;
+    for (double i = 2; i <= k; ++i) {
+        permutations *= i;
+    }
+    const double combinations = choose(N, k);
+    plan.combinations = combinations;
+    const double embeddings = permutations * combinations;
+    plan.embeddings = toBytes(embeddings);
+    plan.combinationSets = choose(combinations, n);
+    plan.configurations = plan.combinationSets * std::pow(permutations, n);
+
+    // Phase 1 indexes the table with IndexType
+    const double indexLimit = static_cast<double>(std::numeric_limits<IndexType>::max());
+    plan.fitsIndexType = permutations <= indexLimit && combinations <= indexLimit;
+
+    // less[m] = number of G cells with fewer than m edges
+    std::array<double, 257> offDiagonalLess{};
+    std::array<double, 257> diagonalLess{};
+    for (IndexType u = 0; u < G.getVertexCount(); ++u) {
+        for (IndexType v = 0; v < G.getVertexCount(); ++v) {
+            auto& histogram = u == v ? diagonalLess : offDiagonalLess;
+            histogram[static_cast<size_t>(G.getEdges(u, v)) + 1] += 1.0;
+        }
+    }
+    for (size_t m = 1; m < offDiagonalLess.size(); ++m) {
+        offDiagonalLess[m] += offDiagonalLess[m - 1];
+        diagonalLess[m] += diagonalLess[m - 1];
+    }
+    const double offDiagonalCells = N * (N - 1);
+    double missingPerEmbedding = 0.0;
+    for (IndexType a = 0; a < P.getVertexCount(); ++a) {
+        for (IndexType b = 0; b < P.getVertexCount(); ++b) {
+            const size_t need = P.getEdges(a, b);
+            if (a == b) {
+                missingPerEmbedding += N > 0 ? diagonalLess[need] / N : 0.0;
+            } else {
+                missingPerEmbedding +=
+                    offDiagonalCells > 0 ? offDiagonalLess[need] / offDiagonalCells : 0.0;
+            }
+        }
+    }
+    plan.missingEdges = std::round(embeddings * missingPerEmbedding);
+
+    // The table: one row per permutation, one list per embedding, the edges of the lists
+    using EdgeList = std::vector<Edge<IndexType>>;
+    plan.phase1Bytes =
+        toBytes(permutations * sizeof(std::vector<EdgeList>) + embeddings * sizeof(EdgeList) +
+                plan.missingEdges * sizeof(Edge<IndexType>) +
+                std::min(embeddings, plan.missingEdges) * PlannerCosts::LIST_OVERHEAD_BYTES);
+
+    // Phase 2: about six arrays over the combinations (bounds, best permutations, order,
+    // warm-start covers), two N × N grids and the partial extension
+    const double kk = k * k;
+    plan.phase2Bytes = toBytes(6.0 * combinations * sizeof(IndexType) + 2.0 * N * N +
+                               static_cast<double>(n) * kk *
+                                   (sizeof(size_t) + sizeof(Edge<IndexType>)));
+
+    // Streaming: one row per cached vertex subset (edges and k! + 1 offsets), and the fixed
+    // tables of StreamingMissingEdges
+    plan.streamingRowBytes =
+        toBytes((combinations > 0 ? plan.missingEdges / combinations : 0.0) *
+                    sizeof(Edge<IndexType>) +
+                (permutations + 1.0) * sizeof(uint32_t) + 64.0);
+    plan.streamingFixedBytes = toBytes(permutations * kk + combinations * sizeof(uint32_t) +
+                                       (N + 1.0) * (k + 1.0) * sizeof(uint64_t));
+
+    // Spill file: header, per subset the padded k! + 1 offsets and its edges, row starts
+    const double spillOffsetsBytes = std::ceil((permutations + 1.0) / 2.0) * 8.0;
+    plan.spillFileBytes = toBytes(40.0 + combinations * spillOffsetsBytes +
+                                  plan.missingEdges * sizeof(Edge<IndexType>) +
+                                  (combinations + 1.0) * sizeof(uint64_t));
+
+    // Compact table: a byte per edge, or two if k > 8 or P has multiplicities above 4 (the
+    // deficit no longer fits next to the vertex pair). Per embedding one uint32 list end, per
+    // subset its vertices, row start and format flag.
+    uint8_t maxPatternEdges = 0;
+    for (IndexType a = 0; a < P.getVertexCount(); ++a) {
+        for (IndexType b = 0; b < P.getVertexCount(); ++b) {
+            maxPatternEdges = std::max(maxPatternEdges, P.getEdges(a, b));
+        }
+    }
+    plan.compactEdgeBytes =
+        toBytes((k > 8 || maxPatternEdges > 4 ? 2.0 : 1.0) * plan.missingEdges);
+    plan.compactBytes = toBytes(static_cast<double>(plan.compactEdgeBytes) +
+                                embeddings * sizeof(uint32_t) +
+                                combinations * (k * sizeof(IndexType) + 1.0) +
+                                (combinations + 1.0) * sizeof(uint64_t));
+
+    plan.phase1Seconds = embeddings * (kk * PlannerCosts::PAIR_SECONDS +
+                                       PlannerCosts::EMBEDDING_SECONDS);
+    plan.phase2Seconds = plan.configurations * PlannerCosts::NODE_SECONDS;
+    return plan;
+}
+
+inline uint64_t ExactPlan::streamingPeakBytes(uint64_t cacheBytes) const {
+    const double rowBytes = static_cast<double>(std::max<uint64_t>(streamingRowBytes, 1));
+    const double rows =
+        std::min(std::max(std::floor(static_cast<double>(cacheBytes) / rowBytes),
+                          static_cast<double>(copies)),
+                 combinations);
+    return PlannerDetail::toBytes(static_cast<double>(streamingFixedBytes) + rows * rowBytes +
+                                  static_cast<double>(phase2Bytes));
+}
+
+inline uint64_t ExactPlan::spilledPeakBytes() const {
+    // The writer holds one row and a 1 MiB buffer
+    return PlannerDetail::toBytes(static_cast<double>(streamingFixedBytes) +
+                                  static_cast<double>(streamingRowBytes) + 1048576.0 +
+                                  static_cast<double>(phase2Bytes));
+}
+
+inline uint64_t ExactPlan::compactPeakBytes() const {
+    return PlannerDetail::toBytes(static_cast<double>(compactBytes) +
+                                  static_cast<double>(copies) *
+                                      static_cast<double>(streamingRowBytes) +
+                                  static_cast<double>(phase2Bytes));
+}
+
+inline std::string formatMemorySize(uint64_t bytes) {
+    constexpr const char* UNITS[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB"};
+    double value = static_cast<double>(bytes);
+    size_t unit = 0;
+    while (value >= 1024.0 && unit + 1 < std::size(UNITS)) {
+        value /= 1024.0;
+        ++unit;
+    }
+    std::ostringstream out;
+    if (unit == 0) {
+        out << bytes << " B";
+    } else {
+        out << std::setprecision(value < 10.0 ? 2 : 3) << value << " " << UNITS[unit];
+    }
+    return out.str();
+}
+
+inline std::optional<uint64_t> parseMemorySize(std::string_view text) {
+    size_t end = text.size();
+    double multiplier = 1.0;
+    // Accept "4G", "4g", "4GB" and "4GiB"
+    if (end >= 2 && (text.substr(end - 2) == "iB" || text.substr(end - 2) == "ib")) {
+        end -= 2;
+    } else if (end >= 1 && (text[end - 1] == 'B' || text[end - 1] == 'b')) {
+        --end;
+    }
+    if (end >= 1) {
+        switch (std::toupper(static_cast<unsigned char>(text[end - 1]))) {
+        case 'K': multiplier = 1024.0; break;
+        case 'M': multiplier = 1024.0 * 1024.0; break;
+        case 'G': multiplier = 1024.0 * 1024.0 * 1024.0; break;
+        case 'T': multiplier = 1024.0 * 1024.0 * 1024.0 * 1024.0; break;
+        default: ++end; break;
+        }
+        --end;
+    }
+    const std::string number(text.substr(0, end));
+    if (number.empty() || number.find_first_not_of("0123456789.") != std::string::npos) {
+        return std::nullopt;
+    }
+    double value = 0.0;
+    try {
+        size_t parsed = 0;
+        value = std::stod(number, &parsed);
+        if (parsed != number.size()) {
+            return std::nullopt;
+        }
+    } catch (...) {
+        return std::nullopt;
+    }
+    const double bytes = value * multiplier;
+    if (bytes <= 0.0 || bytes >= 1.8e19) {
+        return std::nullopt;
+    }
+    return static_cast<uint64_t>(bytes);
+}
+
+inline void ExactPlan::print(std::ostream& out) const {
+    auto seconds = [](double value) {
+        std::ostringstream text;
+        if (value < 1.0) {
+            text << std::setprecision(2) << value * 1000.0 << " ms";
+        } else if (value < 3600.0 * 24.0 * 365.0) {
+            text << std::setprecision(3) << value << " s";
+        } else {
+            text << std::setprecision(2) << value / (3600.0 * 24.0 * 365.0) << " years";
+        }
+        return text.str();
+    };
+    out << "Embeddings:          " << embeddings << "\n"
+        << "Combination sets:    " << std::setprecision(6) << combinationSets << "\n"
+        << "Configurations:      " << configurations << " (worst case)\n"
+        << "Missing edges:       " << missingEdges << "\n"
+        << "Phase 1 memory:      " << formatMemorySize(phase1Bytes) << "\n"
+        << "Phase 2 memory:      " << formatMemorySize(phase2Bytes) << "\n"
+        << "Peak memory:         " << formatMemorySize(peakBytes()) << "\n"
+        << "Streaming memory:    " << formatMemorySize(streamingPeakBytes(0)) << " with "
+        << copies << " cached subset(s), + " << formatMemorySize(streamingRowBytes)
+        << " per additional one\n"
+        << "Spilled table:       " << formatMemorySize(spillFileBytes) << " on disk, "
+        << formatMemorySize(spilledPeakBytes()) << " in memory\n"
+        << "Compact table:       " << formatMemorySize(compactBytes) << ", peak "
+        << formatMemorySize(compactPeakBytes()) << "\n"
+        << "Phase 1 time:        " << seconds(phase1Seconds) << "\n"
+        << "Phase 2 time:        " << seconds(phase2Seconds) << " (worst case, no pruning)\n";
+    if (!fitsIndexType) {
+        out << "Index type:          too small for k! or C(N, k)\n";
+    }
+}
+
+} // namespace Subgraphs
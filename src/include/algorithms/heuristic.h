@@ -1,6 +1,11 @@
 #pragma once
 
+#include <array>
+#include <optional>
+#include <string_view>
+
 #include "../graph/multigraph.h"
+#include "../utils/trace.h"
 
 namespace Subgraphs {
 
@@ -13,6 +18,19 @@ enum class HeuristicType {
     GREEDY_NEIGHBOR = 6
 };
 
+inline constexpr std::array<HeuristicType, 6> ALL_HEURISTICS = {
+    HeuristicType::DEGREE_DIFFERENCE,
+    HeuristicType::DIRECTED_DEGREE,
+    HeuristicType::DIRECTED_DEGREE_IGNORE_SURPLUS,
+    HeuristicType::NEIGHBOR_HISTOGRAM,
+    HeuristicType::STRUCTURE_MATCHING,
+    HeuristicType::GREEDY_NEIGHBOR,
+};
+
+// Command-line name of a heuristic ("degree", "directed", ...)
+inline std::string_view heuristicName(HeuristicType heuristic);
+inline std::optional<HeuristicType> parseHeuristic(std::string_view name);
+
 template <typename IndexType>
 class Heuristic {
   public:
@@ -1,6 +1,33 @@
 
 namespace Subgraphs {
 
+inline std::string_view heuristicName(HeuristicType heuristic) {
+    switch (heuristic) {
+        case HeuristicType::DEGREE_DIFFERENCE:
+            return "degree";
+        case HeuristicType::DIRECTED_DEGREE:
+            return "directed";
+        case HeuristicType::DIRECTED_DEGREE_IGNORE_SURPLUS:
+            return "directed_ignore";
+        case HeuristicType::NEIGHBOR_HISTOGRAM:
+            return "histogram";
+        case HeuristicType::STRUCTURE_MATCHING:
+            return "structure";
+        case HeuristicType::GREEDY_NEIGHBOR:
+            return "greedy";
+    }
+    return "degree";
+}
+
+inline std::optional<HeuristicType> parseHeuristic(std::string_view name) {
+    for (HeuristicType heuristic : ALL_HEURISTICS) {
+        if (heuristicName(heuristic) == name) {
+            return heuristic;
+        }
+    }
+    return std::nullopt;
+}
+
 /**
  * Heuristic 1: Degree Difference (Simplest and Fastest)
  *
@@ -309,8 +336,12 @@ std::vector<std::vector<double>> Heuristic<IndexType>::createWeightMatrix_Greedy
     auto totalDegreesP = P.getDegrees();
     auto totalDegreesG = G.getDegrees();
 
-    // Use Heuristic 1 as base cost for individual neighbor pairs
-    auto baseCost = createWeightMatrix_DegreeDifference(P, G, subset);
+    // Heuristic 1 (degree difference) is the base cost for individual neighbor pairs.
+    // Neighbors are arbitrary G vertices (not necessarily in `subset`), so the cost is
+    // computed from the degree vectors rather than looked up in a k×k matrix.
+    auto baseCost = [&](IndexType pNeighbor, IndexType gNeighbor) {
+        return static_cast<double>(std::abs(totalDegreesP[pNeighbor] - totalDegreesG[gNeighbor]));
+    };
 
     // For each P vertex and G vertex pair
     for (IndexType i = 0; i < k; ++i) {
@@ -342,7 +373,7 @@ std::vector<std::vector<double>> Heuristic<IndexType>::createWeightMatrix_Greedy
                     for (size_t gi = 0; gi < gSize; ++gi) {
                         if (!gAssigned[gi]) {
                             IndexType gNeighborVertex = gNeighbors[gi].first;
-                            double cost = baseCost[pNeighborVertex][gNeighborVertex];
+                            double cost = baseCost(pNeighborVertex, gNeighborVertex);
                             if (cost < bestCost) {
                                 bestCost = cost;
                                 bestGIdx = gi;
@@ -405,6 +436,8 @@ template <typename IndexType>
 std::vector<std::vector<double>> Heuristic<IndexType>::createWeightMatrix(
     const Multigraph<IndexType>& P, const Multigraph<IndexType>& G,
     const std::vector<IndexType>& subset, HeuristicType heuristic) {
+    TraceSpan span("createWeightMatrix", "heuristic", "heuristic",
+                   static_cast<int64_t>(heuristic));
 
     switch (heuristic) {
         case HeuristicType::DEGREE_DIFFERENCE:
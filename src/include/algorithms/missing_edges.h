@@ -0,0 +1,250 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "../graph/edge.h"
+#include "../graph/multigraph.h"
+#include "../utils/mapped_file.h"
+#include "exact_planner.h"
+
+namespace Subgraphs {
+
+/**
+ * Missing-Edge Sources of the Exact Search
+ *
+ * Phase 2 (SubgraphAlgorithm::findMinimalExtensionFrom) reads the missing edges of the
+ * embedding (permutation, combination) through
+ *
+ *     std::span<const Edge<IndexType>> edges(IndexType permutation, IndexType combination)
+ *
+ * The span stays valid until the next call. Full passes over all embeddings visit them
+ * combination by combination, all permutations of a combination in a row.
+ */
+
+// The materialized Phase 1 table of getAllMissingEdges
+template <typename IndexType> class MissingEdgeTable {
+  public:
+    using Table = std::vector<std::vector<std::vector<Edge<IndexType>>>>;
+
+    explicit MissingEdgeTable(const Table& missingEdges) : table(missingEdges) {}
+
+    std::span<const Edge<IndexType>> edges(IndexType permutation, IndexType combination) const {
+        return table[static_cast<size_t>(permutation)][static_cast<size_t>(combination)];
+    }
+
+  private:
+    const Table& table;
+};
+
+/**
+ * Cache of Missing-Edge Rows
+ *
+ * A row holds the missing edges of all k! permutations of one vertex subset. Rows live in a
+ * fixed number of slots and the least recently used one is replaced when a subset that is
+ * not cached is requested; `fill` then produces its row. The slots form a doubly linked
+ * recency list, so hits and evictions are O(1) whatever the capacity.
+ */
+template <typename IndexType> class MissingEdgeRows {
+  public:
+    MissingEdgeRows(size_t numCombs, size_t cacheRows);
+
+    // fill(combination, offsets, edges) appends the row's k! + 1 offsets and its edges
+    template <typename Fill>
+    std::span<const Edge<IndexType>> edges(IndexType permutation, IndexType combination,
+                                           Fill&& fill);
+
+    size_t capacity() const { return rowCapacity; }
+    uint64_t hits() const { return hitCount; }
+    uint64_t misses() const { return missCount; }
+
+  private:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    struct Row {
+        IndexType combination{};
+        uint32_t newer{NO_SLOT}; // Neighbours in the recency list
+        uint32_t older{NO_SLOT};
+        std::vector<uint32_t> offsets; // Edges of permutation p: [offsets[p], offsets[p + 1])
+        std::vector<Edge<IndexType>> edges;
+    };
+
+    uint32_t slotFor(IndexType combination);
+    void unlink(uint32_t slot);
+    void pushNewest(uint32_t slot);
+
+    size_t rowCapacity;
+    std::vector<uint32_t> slotOf; // Per combination: its row's slot or NO_SLOT
+    std::vector<Row> rows;
+    uint32_t newest = NO_SLOT; // Ends of the recency list
+    uint32_t oldest = NO_SLOT;
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+};
+
+/**
+ * Missing Edges Computed on Demand
+ *
+ * Instead of the k! × C(N, k) lists of Phase 1, only the rows of recently used vertex
+ * subsets are kept (MissingEdgeRows), so memory is bounded by the capacity whatever the
+ * size of the search space.
+ *
+ * A row costs k! × k² comparisons, about what Phase 1 spends on the subset. The search
+ * evaluates (k!)^n permutation sequences per combination set, so recomputing the row of
+ * each set's copies is negligible, and nothing is recomputed within a set as long as the
+ * capacity holds at least n rows (it is raised to n).
+ *
+ * Combinations are unranked in the lexicographic order of CombinationRange, so the ranks
+ * match getAllMissingEdges and the search explores the same configurations.
+ */
+template <typename IndexType> class StreamingMissingEdges {
+  public:
+    StreamingMissingEdges(const Multigraph<IndexType>& P, const Multigraph<IndexType>& G,
+                          size_t cacheRows);
+
+    std::span<const Edge<IndexType>> edges(IndexType permutation, IndexType combination) {
+        return rows.edges(permutation, combination,
+                          [this](IndexType comb, std::vector<uint32_t>& offsets,
+                                 std::vector<Edge<IndexType>>& edges) {
+                              compute(comb, offsets, edges);
+                          });
+    }
+
+    size_t capacity() const { return rows.capacity(); }
+    uint64_t hits() const { return rows.hits(); }
+    uint64_t misses() const { return rows.misses(); }
+
+  private:
+    void compute(IndexType combination, std::vector<uint32_t>& offsets,
+                 std::vector<Edge<IndexType>>& edges);
+    void unrank(IndexType combination);
+
+    const Multigraph<IndexType>& target;
+    IndexType k;
+    IndexType numPerms;
+    // permutedP[(p × k + i) × k + j] = edges of P between perm_p[i] and perm_p[j]
+    std::vector<uint8_t> permutedP;
+    // choose[a × (k + 1) + b] = C(a, b), saturated
+    std::vector<uint64_t> choose;
+    MissingEdgeRows<IndexType> rows;
+    std::vector<IndexType> vertices; // Scratch: the unranked combination
+    std::vector<uint8_t> induced;    // Scratch: G restricted to it, k × k
+};
+
+/**
+ * Phase 1 Table Spilled to a Memory-Mapped File
+ *
+ * The table of getAllMissingEdges, written once to a scratch file and read back through
+ * the page cache, for instances whose table is larger than the memory that can be spared.
+ * Only the page cache holds it, so the kernel evicts cold rows under memory pressure and
+ * reads them back from disk when needed.
+ *
+ * The file is combination-major, the order of every pass over all embeddings:
+ *
+ *     [SpillFileHeader]
+ *     per combination: [uint32 offsets[k! + 1], padded to 8 bytes][Edge records, padded]
+ *     [uint64 rowStarts[C(N, k) + 1]]   byte offset of each combination's block
+ *
+ * The bound and warm-start passes therefore read it front to back, and the search reads
+ * whole blocks: a combination set touches the n blocks of its subsets, and the subset of
+ * the last copy advances through the file in order. Edge records are the in-memory Edge
+ * layout, so edges() returns spans into the mapping without decoding. The file is written
+ * with the rows of StreamingMissingEdges, so it holds exactly the Phase 1 lists.
+ *
+ * The scratch file is deleted by the destructor (a crashed process leaves it behind).
+ */
+template <typename IndexType> class SpilledMissingEdges {
+  public:
+    // Writes the table of P in G to `path` (replacing it) and maps it
+    SpilledMissingEdges(const Multigraph<IndexType>& P, const Multigraph<IndexType>& G,
+                        std::filesystem::path path);
+    SpilledMissingEdges(const SpilledMissingEdges&) = delete;
+    SpilledMissingEdges& operator=(const SpilledMissingEdges&) = delete;
+    ~SpilledMissingEdges();
+
+    std::span<const Edge<IndexType>> edges(IndexType permutation, IndexType combination) const;
+
+    const std::filesystem::path& path() const { return filePath; }
+    uint64_t fileBytes() const { return file ? file->size() : 0; }
+
+  private:
+    struct SpillFileHeader {
+        char magic[8];
+        uint32_t edgeBytes; // sizeof(Edge<IndexType>)
+        uint32_t k;
+        uint64_t permutations;
+        uint64_t combinations;
+        uint64_t rowStartsOffset;
+    };
+
+    static constexpr char SPILL_MAGIC[8] = {'S', 'G', 'S', 'P', 'I', 'L', 'L', '1'};
+
+    static constexpr uint64_t padded(uint64_t bytes) { return (bytes + 7) / 8 * 8; }
+    void write(const Multigraph<IndexType>& P, const Multigraph<IndexType>& G) const;
+
+    std::filesystem::path filePath;
+    std::optional<MappedFile> file;
+    const char* data = nullptr;
+    const uint64_t* rowStarts = nullptr;
+    size_t numPerms = 0;
+    size_t offsetsBytes = 0; // Offsets of one block, padded
+};
+
+/**
+ * Phase 1 Table in a Compact Encoding
+ *
+ * Most deficits are a few edges of small multiplicity, yet every Edge of the table stores two
+ * global vertex indices, and every embedding pays for a vector and its allocation. Here a
+ * missing edge is a byte: its local pair (i, j) of positions within the vertex subset and its
+ * deficit d, as i << 5 | j << 2 | (d - 1). A subset with k > 8 or a deficit above 4 stores
+ * the pair as i << 4 | j and the deficits as separate bytes instead. The lists of a subset
+ * are contiguous, with one uint32 end offset per embedding:
+ *
+ *     row of subset c: for each permutation p: [edge bytes] or [pair bytes][deficit bytes]
+ *
+ * The G vertices of the subsets are kept once, k per subset. They are resolved when the
+ * search first needs a subset: its row is decoded into MissingEdgeRows, and the search reads
+ * plain Edge spans. A combination set keeps its subsets for all (k!)^n permutation sequences,
+ * so each row is decoded about once per set, and with n cached rows Phase 2 runs as fast as
+ * with the table. Decoding each edge in the search instead cost a third more time, mostly
+ * for looking up its G vertices.
+ *
+ * Lists are built in the order of getAllMissingEdges, so the search explores the same
+ * configurations and returns the same extension. Requires k <= 16.
+ */
+template <typename IndexType> class CompactMissingEdges {
+  public:
+    CompactMissingEdges(const Multigraph<IndexType>& P, const Multigraph<IndexType>& G,
+                        size_t cacheRows);
+
+    std::span<const Edge<IndexType>> edges(IndexType permutation, IndexType combination) {
+        return rows.edges(permutation, combination,
+                          [this](IndexType comb, std::vector<uint32_t>& offsets,
+                                 std::vector<Edge<IndexType>>& edges) {
+                              decode(comb, offsets, edges);
+                          });
+    }
+
+    // Heap bytes of the encoding, without the cached rows
+    uint64_t bytes() const;
+
+  private:
+    void decode(IndexType combination, std::vector<uint32_t>& offsets,
+                std::vector<Edge<IndexType>>& edges) const;
+
+    IndexType k;
+    size_t numPerms;
+    std::vector<IndexType> vertices;  // vertices[c × k + i] = i-th G vertex of subset c
+    std::vector<uint64_t> rowStarts;  // Per subset: start of its row in `encoded`, then the end
+    std::vector<uint32_t> listEnds;   // listEnds[c × k! + p]: end of the list within the row
+    std::vector<uint8_t> splitRows;   // Per subset: 1 if it stores pairs and deficits apart
+    std::vector<uint8_t> encoded;
+    MissingEdgeRows<IndexType> rows;
+};
+
+} // namespace Subgraphs
+
+#include "missing_edges.inl"
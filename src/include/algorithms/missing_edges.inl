@@ -0,0 +1,397 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include "../utils/trace.h"
+
+namespace Subgraphs {
+
+template <typename IndexType>
+MissingEdgeRows<IndexType>::MissingEdgeRows(size_t numCombs, size_t cacheRows) {
+    if (numCombs >= NO_SLOT) {
+        throw std::length_error("Too many vertex subsets for a row cache");
+    }
+    rowCapacity = std::clamp<size_t>(cacheRows, 1, std::max<size_t>(numCombs, 1));
+    slotOf.assign(numCombs, NO_SLOT);
+    rows.reserve(rowCapacity);
+}
+
+template <typename IndexType>
+template <typename Fill>
+std::span<const Edge<IndexType>>
+MissingEdgeRows<IndexType>::edges(IndexType permutation, IndexType combination, Fill&& fill) {
+    uint32_t slot = slotOf[static_cast<size_t>(combination)];
+    if (slot == NO_SLOT) {
+        slot = slotFor(combination);
+        Row& row = rows[slot];
+        row.offsets.clear();
+        row.edges.clear();
+        fill(combination, row.offsets, row.edges);
+        ++missCount;
+    } else {
+        ++hitCount;
+        if (slot != newest) {
+            unlink(slot);
+            pushNewest(slot);
+        }
+    }
+    const Row& row = rows[slot];
+    const uint32_t begin = row.offsets[static_cast<size_t>(permutation)];
+    const uint32_t end = row.offsets[static_cast<size_t>(permutation) + 1];
+    return {row.edges.data() + begin, end - begin};
+}
+
+template <typename IndexType>
+uint32_t MissingEdgeRows<IndexType>::slotFor(IndexType combination) {
+    uint32_t slot = 0;
+    if (rows.size() < rowCapacity) {
+        slot = static_cast<uint32_t>(rows.size());
+        rows.emplace_back();
+    } else {
+        // Evict the least recently used row; its buffers are reused
+        slot = oldest;
+        unlink(slot);
+        slotOf[static_cast<size_t>(rows[slot].combination)] = NO_SLOT;
+    }
+    pushNewest(slot);
+    slotOf[static_cast<size_t>(combination)] = slot;
+    rows[slot].combination = combination;
+    return slot;
+}
+
+template <typename IndexType>
+void MissingEdgeRows<IndexType>::unlink(uint32_t slot) {
+    Row& row = rows[slot];
+    (row.newer != NO_SLOT ? rows[row.newer].older : newest) = row.older;
+    (row.older != NO_SLOT ? rows[row.older].newer : oldest) = row.newer;
+    row.newer = NO_SLOT;
+    row.older = NO_SLOT;
+}
+
+template <typename IndexType>
+void MissingEdgeRows<IndexType>::pushNewest(uint32_t slot) {
+    Row& row = rows[slot];
+    row.older = newest;
+    (newest != NO_SLOT ? rows[newest].newer : oldest) = slot;
+    newest = slot;
+}
+
+template <typename IndexType>
+StreamingMissingEdges<IndexType>::StreamingMissingEdges(const Multigraph<IndexType>& P,
+                                                        const Multigraph<IndexType>& G,
+                                                        size_t cacheRows)
+    : target(G), k(P.getVertexCount()), numPerms(static_cast<IndexType>(P.permutationsCount())),
+      rows(static_cast<size_t>(G.combinationsCount(P.getVertexCount())), cacheRows) {
+    const size_t kk = static_cast<size_t>(k) * static_cast<size_t>(k);
+    permutedP.reserve(static_cast<size_t>(numPerms) * kk);
+    for (const auto& perm : P.permutations()) {
+        for (IndexType i = 0; i < k; ++i) {
+            for (IndexType j = 0; j < k; ++j) {
+                permutedP.push_back(P.getEdges(perm[i], perm[j]));
+            }
+        }
+    }
+
+    const size_t N = static_cast<size_t>(G.getVertexCount());
+    const size_t width = static_cast<size_t>(k) + 1;
+    choose.assign((N + 1) * width, 0);
+    for (size_t a = 0; a <= N; ++a) {
+        choose[a * width] = 1;
+        for (size_t b = 1; b < width && b <= a; ++b) {
+            const uint64_t sum = choose[(a - 1) * width + b - 1] + choose[(a - 1) * width + b];
+            choose[a * width + b] = sum < choose[(a - 1) * width + b] ? UINT64_MAX : sum;
+        }
+    }
+
+    vertices.resize(static_cast<size_t>(k));
+    induced.resize(kk);
+}
+
+// Lexicographic unranking: vertex x is the next element as long as fewer combinations start
+// with a smaller one than `rank` still has to skip
+template <typename IndexType>
+void StreamingMissingEdges<IndexType>::unrank(IndexType combination) {
+    const size_t N = static_cast<size_t>(target.getVertexCount());
+    const size_t width = static_cast<size_t>(k) + 1;
+    uint64_t rank = static_cast<uint64_t>(combination);
+    size_t x = 0;
+    for (size_t i = 0; i < static_cast<size_t>(k); ++i) {
+        const size_t remaining = static_cast<size_t>(k) - 1 - i;
+        while (choose[(N - 1 - x) * width + remaining] <= rank) {
+            rank -= choose[(N - 1 - x) * width + remaining];
+            ++x;
+        }
+        vertices[i] = static_cast<IndexType>(x);
+        ++x;
+    }
+}
+
+template <typename IndexType>
+void StreamingMissingEdges<IndexType>::compute(IndexType combination,
+                                               std::vector<uint32_t>& offsets,
+                                               std::vector<Edge<IndexType>>& edges) {
+    unrank(combination);
+    const size_t kk = static_cast<size_t>(k) * static_cast<size_t>(k);
+    for (IndexType i = 0; i < k; ++i) {
+        for (IndexType j = 0; j < k; ++j) {
+            induced[static_cast<size_t>(i) * static_cast<size_t>(k) + static_cast<size_t>(j)] =
+                target.getEdges(vertices[i], vertices[j]);
+        }
+    }
+    // Same order as getAllMissingEdges: by permutation, then by (i, j)
+    for (size_t perm = 0; perm < static_cast<size_t>(numPerms); ++perm) {
+        offsets.push_back(static_cast<uint32_t>(edges.size()));
+        const uint8_t* pattern = permutedP.data() + perm * kk;
+        for (size_t cell = 0; cell < kk; ++cell) {
+            if (pattern[cell] > induced[cell]) {
+                edges.emplace_back(vertices[cell / static_cast<size_t>(k)],
+                                   vertices[cell % static_cast<size_t>(k)],
+                                   static_cast<uint8_t>(pattern[cell] - induced[cell]));
+            }
+        }
+    }
+    offsets.push_back(static_cast<uint32_t>(edges.size()));
+}
+
+template <typename IndexType>
+SpilledMissingEdges<IndexType>::SpilledMissingEdges(const Multigraph<IndexType>& P,
+                                                    const Multigraph<IndexType>& G,
+                                                    std::filesystem::path path)
+    : filePath(std::move(path)), numPerms(static_cast<size_t>(P.permutationsCount())),
+      offsetsBytes(static_cast<size_t>(padded((numPerms + 1) * sizeof(uint32_t)))) {
+    try {
+        write(P, G);
+        file.emplace(filePath, MappedFile::Access::DEFAULT);
+        SpillFileHeader header;
+        const uint64_t numCombs = G.combinationsCount(P.getVertexCount());
+        if (file->size() < sizeof(header)) {
+            throw std::runtime_error("Truncated spill file: " + filePath.string());
+        }
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (std::memcmp(header.magic, SPILL_MAGIC, sizeof(header.magic)) != 0 ||
+            header.edgeBytes != sizeof(Edge<IndexType>) || header.permutations != numPerms ||
+            header.combinations != numCombs || header.rowStartsOffset % 8 != 0 ||
+            header.rowStartsOffset + (numCombs + 1) * sizeof(uint64_t) != file->size()) {
+            throw std::runtime_error("Corrupt spill file: " + filePath.string());
+        }
+        data = file->data();
+        rowStarts = reinterpret_cast<const uint64_t*>(data + header.rowStartsOffset);
+    } catch (...) {
+        file.reset();
+        std::error_code ignored;
+        std::filesystem::remove(filePath, ignored);
+        throw;
+    }
+}
+
+template <typename IndexType> SpilledMissingEdges<IndexType>::~SpilledMissingEdges() {
+    file.reset();
+    std::error_code ignored;
+    std::filesystem::remove(filePath, ignored);
+}
+
+template <typename IndexType>
+std::span<const Edge<IndexType>>
+SpilledMissingEdges<IndexType>::edges(IndexType permutation, IndexType combination) const {
+    const char* block = data + rowStarts[static_cast<size_t>(combination)];
+    const auto* offsets = reinterpret_cast<const uint32_t*>(block);
+    const auto* records = reinterpret_cast<const Edge<IndexType>*>(block + offsetsBytes);
+    const uint32_t begin = offsets[static_cast<size_t>(permutation)];
+    const uint32_t end = offsets[static_cast<size_t>(permutation) + 1];
+    return {records + begin, end - begin};
+}
+
+template <typename IndexType>
+void SpilledMissingEdges<IndexType>::write(const Multigraph<IndexType>& P,
+                                           const Multigraph<IndexType>& G) const {
+    static_assert(std::is_trivially_copyable_v<Edge<IndexType>> && alignof(Edge<IndexType>) <= 8,
+                  "Edge records are mapped in place");
+    TraceSpan span("spill missing edges", "exact");
+    const IndexType k = P.getVertexCount();
+    const uint64_t numCombs = G.combinationsCount(k);
+
+    // Large buffer: the file is written strictly front to back, except the header
+    std::vector<char> buffer(size_t{1} << 20);
+    std::ofstream out;
+    out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Could not create spill file: " + filePath.string());
+    }
+
+    SpillFileHeader header{};
+    std::memcpy(header.magic, SPILL_MAGIC, sizeof(header.magic));
+    header.edgeBytes = static_cast<uint32_t>(sizeof(Edge<IndexType>));
+    header.k = static_cast<uint32_t>(k);
+    header.permutations = numPerms;
+    header.combinations = numCombs;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const char zeros[8] = {};
+    auto writePadded = [&](const void* bytes, uint64_t size) {
+        out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        out.write(zeros, static_cast<std::streamsize>(padded(size) - size));
+        return padded(size);
+    };
+
+    // One row at a time: computing a row gives the edges of all permutations back to back
+    StreamingMissingEdges<IndexType> rows(P, G, 1);
+    std::vector<uint64_t> starts;
+    starts.reserve(static_cast<size_t>(numCombs) + 1);
+    std::vector<uint32_t> offsets(numPerms + 1, 0);
+    uint64_t position = sizeof(header);
+    for (uint64_t comb = 0; comb < numCombs; ++comb) {
+        starts.push_back(position);
+        const Edge<IndexType>* first = nullptr;
+        for (size_t perm = 0; perm < numPerms; ++perm) {
+            const auto edges =
+                rows.edges(static_cast<IndexType>(perm), static_cast<IndexType>(comb));
+            first = perm == 0 ? edges.data() : first;
+            offsets[perm + 1] = offsets[perm] + static_cast<uint32_t>(edges.size());
+        }
+        position += writePadded(offsets.data(), offsets.size() * sizeof(uint32_t));
+        position += writePadded(first, uint64_t{offsets[numPerms]} * sizeof(Edge<IndexType>));
+    }
+    starts.push_back(position);
+    header.rowStartsOffset = position;
+    writePadded(starts.data(), starts.size() * sizeof(uint64_t));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Could not write spill file: " + filePath.string());
+    }
+}
+
+template <typename IndexType>
+CompactMissingEdges<IndexType>::CompactMissingEdges(const Multigraph<IndexType>& P,
+                                                    const Multigraph<IndexType>& G,
+                                                    size_t cacheRows)
+    : k(P.getVertexCount()), numPerms(static_cast<size_t>(P.permutationsCount())),
+      rows(static_cast<size_t>(G.combinationsCount(P.getVertexCount())), cacheRows) {
+    if (k > 16) {
+        throw std::length_error("The compact table packs vertex pairs into a byte (k <= 16)");
+    }
+    TraceSpan span("compact missing edges", "exact");
+    const size_t kk = static_cast<size_t>(k) * static_cast<size_t>(k);
+    const size_t numCombs = static_cast<size_t>(G.combinationsCount(k));
+
+    // The planner's bound on the encoded lists is tight, so they are appended without
+    // reallocating (a grown vector would briefly need up to three times the memory)
+    encoded.reserve(static_cast<size_t>(planExact(1, P, G).compactEdgeBytes));
+    vertices.reserve(numCombs * static_cast<size_t>(k));
+    rowStarts.reserve(numCombs + 1);
+    listEnds.reserve(numCombs * numPerms);
+    splitRows.reserve(numCombs);
+
+    std::vector<uint8_t> permutedP;
+    permutedP.reserve(numPerms * kk);
+    for (const auto& perm : P.permutations()) {
+        for (IndexType i = 0; i < k; ++i) {
+            for (IndexType j = 0; j < k; ++j) {
+                permutedP.push_back(P.getEdges(perm[i], perm[j]));
+            }
+        }
+    }
+
+    // Scratch for one row: the local pairs (i, j) and deficits of all permutations, and where
+    // the list of each permutation ends
+    std::vector<uint8_t> induced(kk);
+    std::vector<uint8_t> pairs;
+    std::vector<uint8_t> deficits;
+    std::vector<size_t> ends(numPerms);
+    for (const auto& comb : G.combinations(k)) {
+        for (IndexType i = 0; i < k; ++i) {
+            vertices.push_back(comb[i]);
+            for (IndexType j = 0; j < k; ++j) {
+                induced[static_cast<size_t>(i) * static_cast<size_t>(k) +
+                        static_cast<size_t>(j)] = G.getEdges(comb[i], comb[j]);
+            }
+        }
+
+        // Same order as getAllMissingEdges: by permutation, then by (i, j)
+        pairs.clear();
+        deficits.clear();
+        uint8_t maxDeficit = 0;
+        for (size_t perm = 0; perm < numPerms; ++perm) {
+            const uint8_t* pattern = permutedP.data() + perm * kk;
+            for (size_t cell = 0; cell < kk; ++cell) {
+                if (pattern[cell] > induced[cell]) {
+                    const auto deficit = static_cast<uint8_t>(pattern[cell] - induced[cell]);
+                    pairs.push_back(static_cast<uint8_t>(cell / static_cast<size_t>(k)));
+                    pairs.push_back(static_cast<uint8_t>(cell % static_cast<size_t>(k)));
+                    deficits.push_back(deficit);
+                    maxDeficit = std::max(maxDeficit, deficit);
+                }
+            }
+            ends[perm] = deficits.size();
+        }
+
+        const bool split = k > 8 || maxDeficit > 4;
+        const size_t rowStart = encoded.size();
+        rowStarts.push_back(rowStart);
+        splitRows.push_back(split ? 1 : 0);
+        size_t first = 0;
+        for (size_t perm = 0; perm < numPerms; ++perm) {
+            const size_t last = ends[perm];
+            for (size_t edge = first; edge < last; ++edge) {
+                const uint8_t i = pairs[2 * edge];
+                const uint8_t j = pairs[2 * edge + 1];
+                encoded.push_back(
+                    split ? static_cast<uint8_t>(i << 4 | j)
+                         : static_cast<uint8_t>(i << 5 | j << 2 | (deficits[edge] - 1)));
+            }
+            if (split) {
+                encoded.insert(encoded.end(),
+                               deficits.begin() + static_cast<std::ptrdiff_t>(first),
+                               deficits.begin() + static_cast<std::ptrdiff_t>(last));
+            }
+            if (encoded.size() - rowStart > UINT32_MAX) {
+                throw std::length_error("Vertex subset too large for the compact table");
+            }
+            listEnds.push_back(static_cast<uint32_t>(encoded.size() - rowStart));
+            first = last;
+        }
+    }
+    rowStarts.push_back(encoded.size());
+}
+
+template <typename IndexType>
+void CompactMissingEdges<IndexType>::decode(IndexType combination, std::vector<uint32_t>& offsets,
+                                            std::vector<Edge<IndexType>>& edges) const {
+    const size_t comb = static_cast<size_t>(combination);
+    const uint8_t* row = encoded.data() + rowStarts[comb];
+    const IndexType* subset = vertices.data() + comb * static_cast<size_t>(k);
+    const bool split = splitRows[comb] != 0;
+    uint32_t begin = 0;
+    for (size_t perm = 0; perm < numPerms; ++perm) {
+        offsets.push_back(static_cast<uint32_t>(edges.size()));
+        const uint32_t end = listEnds[comb * numPerms + perm];
+        const uint8_t* list = row + begin;
+        if (split) {
+            const uint32_t count = (end - begin) / 2;
+            for (uint32_t edge = 0; edge < count; ++edge) {
+                edges.emplace_back(subset[list[edge] >> 4], subset[list[edge] & 0x0F],
+                                   list[count + edge]);
+            }
+        } else {
+            for (uint32_t edge = 0; edge < end - begin; ++edge) {
+                edges.emplace_back(subset[list[edge] >> 5], subset[(list[edge] >> 2) & 0x07],
+                                   static_cast<uint8_t>((list[edge] & 0x03) + 1));
+            }
+        }
+        begin = end;
+    }
+    offsets.push_back(static_cast<uint32_t>(edges.size()));
+}
+
+template <typename IndexType> uint64_t CompactMissingEdges<IndexType>::bytes() const {
+    return vertices.capacity() * sizeof(IndexType) + rowStarts.capacity() * sizeof(uint64_t) +
+           listEnds.capacity() * sizeof(uint32_t) + splitRows.capacity() + encoded.capacity();
+}
+
+} // namespace Subgraphs
@@ -3,30 +3,197 @@
 #include "../graph/edge.h"
 #include "../graph/multigraph.h"
 #include "../graph/sequence_iterator.h"
+#include "../utils/binary_format.h"
+#include "../utils/exact_checkpoint.h"
+#include "../utils/search_statistics.h"
+#include "../utils/thread_pool.h"
+#include "../utils/trace.h"
 #include "Hungarian.h"
+#include "exact_planner.h"
+#include "missing_edges.h"
 #include "heuristic.h"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <filesystem>
 #include <numeric>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
 #include <unordered_set>
 
 namespace Subgraphs {
 
+enum class AlgorithmType {
+    EXACT,
+    APPROX1,
+    APPROX2,
+    PORTFOLIO,
+};
+
+inline constexpr std::array<AlgorithmType, 4> ALL_ALGORITHMS = {
+    AlgorithmType::EXACT,
+    AlgorithmType::APPROX1,
+    AlgorithmType::APPROX2,
+    AlgorithmType::PORTFOLIO,
+};
+
+// Command-line name of an algorithm ("exact", "approx1", ...)
+inline std::string_view algorithmName(AlgorithmType algorithm);
+inline std::optional<AlgorithmType> parseAlgorithm(std::string_view name);
+
+// Outcome of a single portfolio member (approx1 or one approx2 heuristic)
+template <typename IndexType = int64_t> struct PortfolioEntry {
+    std::string name;                       // "approx1", "approx2_degree", ...
+    std::vector<Edge<IndexType>> extension; // Edges the member proposes to add
+    uint64_t cost{};                        // Total multiplicity of the extension
+    double milliseconds{};                  // Wall-clock time of the member
+};
+
+// Wall-clock breakdown of a run in milliseconds. Phases an algorithm does not have stay 0:
+//   exact:   phase1 = missing edges of all embeddings, phase2 = search for the n copies
+//   approx1: phase1 = greedy seed extension, phase2 = selection, merge = max-merge
+//   approx2: phase1 = heuristic weight matrices, assignment = Hungarian, merge = max-merge
+// loadMs is not filled by the algorithms; it is left for the caller that loads the graphs.
+struct PhaseTimings {
+    double loadMs{};
+    double phase1Ms{};
+    double phase2Ms{};
+    double assignmentMs{};
+    double mergeMs{};
+};
+
+// Where the exact search gets the missing edges of an embedding from
+enum class MissingEdgeStorage {
+    TABLE,     // Phase 1 materializes all k! × C(N, k) lists (fastest, most memory)
+    STREAMING, // Computed in the search, with an LRU cache of vertex subsets (see
+               // StreamingMissingEdges)
+    SPILLED,   // Phase 1 writes the table to a scratch file in spillDirectory and the
+               // search reads it memory-mapped (see SpilledMissingEdges)
+    COMPACT,   // The table with one or two bytes per missing edge (see
+               // CompactMissingEdges)
+};
+
+// Limits and reporting for the exact search (run_exact)
+struct ExactOptions {
+    double timeLimitSeconds{0.0};           // Return the best extension found so far after this
+                                            // long (from the start of run_exact); 0 = none
+    std::ostream* progress{nullptr};        // Receives a progress line every
+    double progressIntervalSeconds{5.0};    // progressIntervalSeconds
+    std::optional<AlgorithmType> warmStart; // Approximation whose solution seeds the search
+                                            // (approx1, approx2 or portfolio)
+    std::filesystem::path checkpointPath;   // Save the search frontier here (empty = never)
+    double checkpointIntervalSeconds{60.0};
+    bool resume{false};                     // Continue from checkpointPath if it exists
+    const std::atomic<bool>* stopRequested{nullptr}; // Stops the search like the time limit
+                                                     // (e.g. set from a signal handler)
+    uint64_t shardIndex{0};                 // Only explore the combination sets of shard
+    uint64_t shardCount{1};                 // shardIndex out of shardCount (see exactShardOf)
+    SearchStatistics* statistics{nullptr};  // Receives search counters when the build has
+                                            // SUBGRAPHS_STATS enabled; untouched otherwise
+    MissingEdgeStorage storage{MissingEdgeStorage::TABLE};
+    uint64_t streamingCacheBytes{64ull << 20}; // Cache budget of STREAMING (at least n rows)
+    std::filesystem::path spillDirectory;      // Where SPILLED puts its scratch file
+};
+
+// State of the exact search when it returned
+struct ExactSearchStats {
+    uint64_t cost{};          // Cost of the returned extension (upper bound on the optimum)
+    uint64_t lowerBound{};    // Proven lower bound on the optimal cost
+    uint64_t nodesExplored{}; // Configurations (and pruned combination sets) visited
+    uint64_t initialCost{};   // Incumbent cost when the search started
+    bool optimal{};           // The search finished, so cost is optimal (for a shard: no
+                              // combination set of the shard is cheaper)
+    uint64_t fingerprint{};   // Hash of P, G, n and the warm start (not the shard), used to
+                              // check that shard results belong to the same problem
+
+    // Relative optimality gap: (cost - lowerBound) / cost, 0 when the extension is optimal
+    double gap() const {
+        return cost == 0 ? 0.0 : static_cast<double>(cost - lowerBound) / static_cast<double>(cost);
+    }
+};
+
+// 64-bit hash of a sequence of vertices (or subset ranks): FNV-1a with a splitmix64
+// finalizer, so the low bits depend on every element
+template <typename IndexType>
+uint64_t hashVertexSequence(const std::vector<IndexType>& vertices);
+
+// Shard (0..shardCount-1) of a combination set of the exact search, given as the ranks of
+// its vertex subsets in the search order. The ranks are hashed rather than cut into
+// contiguous ranges: the lexicographically first sets hold most of the work, and their
+// numeric rank does not fit into 64 bits for realistic sizes.
+template <typename IndexType>
+uint64_t exactShardOf(const std::vector<IndexType>& ranks, uint64_t shardCount);
+
 template <typename IndexType = int64_t>
 class SubgraphAlgorithm {
   public:
+    // When `timings` is provided, the time of each phase is added to it
     static std::vector<Edge<IndexType>> run(int n, Multigraph<IndexType>& P,
-                                            Multigraph<IndexType>& G);
+                                            Multigraph<IndexType>& G,
+                                            PhaseTimings* timings = nullptr);
+    // Anytime variant of run: stops at the time limit with the best extension found so far
+    // and reports its bounds in `stats`
+    static std::vector<Edge<IndexType>> run_exact(int n, Multigraph<IndexType>& P,
+                                                  Multigraph<IndexType>& G,
+                                                  const ExactOptions& options,
+                                                  ExactSearchStats* stats = nullptr,
+                                                  PhaseTimings* timings = nullptr);
+    // threadCount bounds the seed evaluation; callers that already run on a pool pass 1.
     static std::vector<Edge<IndexType>> run_approx_v1(int n, Multigraph<IndexType>& P,
-                                            Multigraph<IndexType>& G);
+                                            Multigraph<IndexType>& G,
+                                            PhaseTimings* timings = nullptr,
+                                            size_t threadCount = ThreadPool::defaultThreadCount());
     static std::vector<Edge<IndexType>> run_approx_v2(int n, Multigraph<IndexType>& P,
-                                            Multigraph<IndexType>& G, HeuristicType heuristic = HeuristicType::DEGREE_DIFFERENCE);
+                                            Multigraph<IndexType>& G, HeuristicType heuristic = HeuristicType::DEGREE_DIFFERENCE,
+                                            PhaseTimings* timings = nullptr);
+    // Members run on up to threadCount threads, one after another when it is 1
+    static std::vector<Edge<IndexType>> run_portfolio(int n, Multigraph<IndexType>& P,
+                                            Multigraph<IndexType>& G,
+                                            std::vector<PortfolioEntry<IndexType>>* report = nullptr,
+                                            size_t threadCount = ThreadPool::defaultThreadCount());
 
-  private:
+    // Dispatches to run / run_approx_v1 / run_approx_v2 / run_portfolio. Portfolio members run
+    // concurrently, so no phase breakdown is recorded for them. threadCount is forwarded to
+    // run_approx_v1 and run_portfolio.
+    static std::vector<Edge<IndexType>> run_algorithm(
+        AlgorithmType algorithm, int n, Multigraph<IndexType>& P, Multigraph<IndexType>& G,
+        HeuristicType heuristic = HeuristicType::DEGREE_DIFFERENCE,
+        PhaseTimings* timings = nullptr,
+        size_t threadCount = ThreadPool::defaultThreadCount());
+
+    static uint64_t extensionCost(const std::vector<Edge<IndexType>>& extension);
+
+    using Clock = std::chrono::steady_clock;
+
+    // The two phases of run_exact, public so they can be benchmarked separately.
+    // Phase 1: missingEdges[permutation][combination] for every embedding of P into G
     static std::vector<std::vector<std::vector<Edge<IndexType>>>>
     getAllMissingEdges(Multigraph<IndexType>& P, Multigraph<IndexType>& G);
 
+    // Phase 2: the cheapest n embeddings on distinct vertex subsets; the time limit is
+    // measured from `searchStart`
     static std::vector<Edge<IndexType>> findMinimalExtension(
         int n, Multigraph<IndexType>& P, Multigraph<IndexType>& G,
-        const std::vector<std::vector<std::vector<Edge<IndexType>>>>& allMissingEdges);
+        const std::vector<std::vector<std::vector<Edge<IndexType>>>>& allMissingEdges,
+        const ExactOptions& options, Clock::time_point searchStart, ExactSearchStats& stats);
+    // Phase 2 on any missing-edge source (MissingEdgeTable, StreamingMissingEdges,
+    // SpilledMissingEdges, CompactMissingEdges)
+    template <typename MissingEdgeSource>
+    static std::vector<Edge<IndexType>> findMinimalExtensionFrom(
+        int n, Multigraph<IndexType>& P, Multigraph<IndexType>& G,
+        MissingEdgeSource& missingEdges, const ExactOptions& options,
+        Clock::time_point searchStart, ExactSearchStats& stats);
+
+  private:
+    // Adds the time elapsed since `start` to `*phase` (if requested) and restarts the clock
+    static void recordPhase(double* phase, Clock::time_point& start);
 };
 
 } // namespace Subgraphs
@@ -1,6 +1,53 @@
 
 namespace Subgraphs {
 
+inline std::string_view algorithmName(AlgorithmType algorithm) {
+    switch (algorithm) {
+        case AlgorithmType::EXACT:
+            return "exact";
+        case AlgorithmType::APPROX1:
+            return "approx1";
+        case AlgorithmType::APPROX2:
+            return "approx2";
+        case AlgorithmType::PORTFOLIO:
+            return "portfolio";
+    }
+    return "exact";
+}
+
+inline std::optional<AlgorithmType> parseAlgorithm(std::string_view name) {
+    for (AlgorithmType algorithm : ALL_ALGORITHMS) {
+        if (algorithmName(algorithm) == name) {
+            return algorithm;
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename IndexType>
+uint64_t hashVertexSequence(const std::vector<IndexType>& vertices) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (IndexType vertex : vertices) {
+        hash = (hash ^ static_cast<uint64_t>(vertex)) * 1099511628211ULL;
+    }
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+template <typename IndexType>
+uint64_t exactShardOf(const std::vector<IndexType>& ranks, uint64_t shardCount) {
+    if (shardCount <= 1) {
+        return 0;
+    }
+    // The finalizer spreads neighbouring sets (which differ only in the last rank) over all
+    // shards
+    return hashVertexSequence(ranks) % shardCount;
+}
+
 /**
  * Phase 1 of Exact Algorithm: Compute Missing Edges for All Embeddings
  *
@@ -29,10 +76,15 @@ template <typename IndexType>
 std::vector<std::vector<std::vector<Edge<IndexType>>>>
 SubgraphAlgorithm<IndexType>::getAllMissingEdges(Multigraph<IndexType>& P,
                                                  Multigraph<IndexType>& G) {
+    TraceSpan span("getAllMissingEdges", "exact");
     const IndexType numPerms = P.permutationsCount();                // k! permutations
     const IndexType numCombs = G.combinationsCount(P.getVertexCount()); // C(n,k) combinations
     const IndexType k = P.getVertexCount();
-    const IndexType estimatedEdgesPerPair = P.getEdgeCount() / 2;     // Heuristic for pre-allocation
+
+    // Each list is collected here and copied out at its exact size: one allocation per
+    // embedding with missing edges and no unused capacity
+    std::vector<Edge<IndexType>> scratch;
+    scratch.reserve(static_cast<size_t>(k) * static_cast<size_t>(k));
 
     // 2D array: missingEdges[permutation][combination] = list of missing edges
     std::vector<std::vector<std::vector<Edge<IndexType>>>> missingEdges(
@@ -46,7 +98,7 @@ SubgraphAlgorithm<IndexType>::getAllMissingEdges(Multigraph<IndexType>& P,
         IndexType combIdx = 0;
         // Iterate through all C(n,k) combinations of G vertices
         for (const auto& comb : G.combinations(k)) {
-            missingEdges[permIdx][combIdx].reserve(estimatedEdgesPerPair);
+            scratch.clear();
 
             // For this specific embedding (perm, comb), check all vertex pairs
             for (IndexType i = 0; i < k; ++i) {
@@ -58,11 +110,11 @@ SubgraphAlgorithm<IndexType>::getAllMissingEdges(Multigraph<IndexType>& P,
 
                     // If P has more edges than G, record the deficit
                     if (pEdges > gEdges) {
-                        missingEdges[permIdx][combIdx].emplace_back(
-                            comb[i], comb[j], pEdges - gEdges);
+                        scratch.emplace_back(comb[i], comb[j], pEdges - gEdges);
                     }
                 }
             }
+            missingEdges[permIdx][combIdx].assign(scratch.begin(), scratch.end());
             ++combIdx;
         }
         ++permIdx;
@@ -89,70 +141,457 @@ SubgraphAlgorithm<IndexType>::getAllMissingEdges(Multigraph<IndexType>& P,
  *   3. For each configuration, compute the minimum edges needed using max-merge
  *   4. Track the configuration with globally minimum edge count
  *
+ * Bounds:
+ *   - A copy on vertex subset c needs at least standalone(c) edges, the cost of its
+ *     cheapest permutation. Every configuration therefore costs at least
+ *     max_i standalone(combs[i]), and any n distinct subsets cost at least the n-th
+ *     smallest standalone cost (the global lower bound).
+ *   - The search starts from an incumbent: the n subsets with the smallest standalone
+ *     costs, each with its cheapest permutation. Its cost is a valid upper bound, so
+ *     pruning works from the first configuration on.
+ *
  * Optimizations:
  *   - Early termination: if current size exceeds best known, skip remaining copies
+ *   - Combination sets whose standalone bound reaches the best known size are skipped,
+ *     and the search ends once no remaining first copy is cheap enough
  *   - Use hash map to efficiently track max multiplicity per edge
  *
+ * Warm start: with options.warmStart, an approximation runs first. The subsets whose
+ * embeddings fit into its extension give a second incumbent (used if cheaper), and they
+ * are explored first, followed by the other subsets in order of standalone cost.
+ *
+ * Checkpoints: with options.checkpointPath, the frontier (next combination set and
+ * permutation sequence, incumbent, bound) is saved every checkpointIntervalSeconds and
+ * when the search stops early; options.resume continues from it. A finished search
+ * deletes the checkpoint.
+ *
+ * Sharding: with options.shardCount > 1, only the combination sets with
+ * exactShardOf(ranks) == shardIndex are explored. Every shard starts from the same
+ * incumbent and lower bound, so the cheapest shard result is the global optimum once
+ * all shards have finished (see ShardResult::merge).
+ *
+ * Anytime behavior: with a time limit (or options.stopRequested), the search returns the
+ * incumbent when the deadline passes, and `stats` holds its cost, the lower bound and the number of
+ * nodes explored. Progress lines go to options.progress.
+ *
+ * Missing edges: the search reads them from any source with the interface of
+ * MissingEdgeTable (see missing_edges.h), e.g. the Phase 1 table or StreamingMissingEdges.
+ * The passes over all embeddings go subset by subset, so a streaming source computes each
+ * row once per pass.
+ *
  * Time Complexity: O(C(C(n,k), m) × (k!)^m × m × k²)
- * Space Complexity: O(n × |E_P|) for the frequency map
+ * Space Complexity: O(n × |E_P|) for the frequency map, plus O(C(n,k)) bounds
  */
 template <typename IndexType>
 std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::findMinimalExtension(
     int n, Multigraph<IndexType>& P, Multigraph<IndexType>& G,
-    const std::vector<std::vector<std::vector<Edge<IndexType>>>>& allMissingEdges) {
-    std::vector<Edge<IndexType>> minimalExtension;         // Best solution found
-    IndexType minSize = std::numeric_limits<IndexType>::max(); // Best size found
+    const std::vector<std::vector<std::vector<Edge<IndexType>>>>& allMissingEdges,
+    const ExactOptions& options, Clock::time_point searchStart, ExactSearchStats& stats) {
+    MissingEdgeTable<IndexType> table(allMissingEdges);
+    return findMinimalExtensionFrom(n, P, G, table, options, searchStart, stats);
+}
 
-    // Map from edge (source, dest) to maximum multiplicity needed across all n copies
-    std::unordered_map<std::pair<IndexType, IndexType>, IndexType> edgeFreqMap;
-    edgeFreqMap.reserve(n * P.getEdgeCount());
+template <typename IndexType>
+template <typename MissingEdgeSource>
+std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::findMinimalExtensionFrom(
+    int n, Multigraph<IndexType>& P, Multigraph<IndexType>& G, MissingEdgeSource& missingEdges,
+    const ExactOptions& options, Clock::time_point searchStart, ExactSearchStats& stats) {
+    TraceSpan span("findMinimalExtension", "exact");
+    const IndexType numPerms = P.permutationsCount();                   // k! permutations
+    const IndexType numCombs = G.combinationsCount(P.getVertexCount()); // C(n,k) combinations
 
-    // Try all m-combinations of vertex subsets (ensures n copies use different vertex sets)
-    for (const auto& combs : CombinationRange<IndexType>(G.combinationsCount(P.getVertexCount()), n)) {
-        // For each combination of subsets, try all m-sequences of permutations
-        // (each copy can use a different ordering/mapping)
-        for (const auto& perms : SequenceRange<IndexType>(P.permutationsCount(), n)) {
-            edgeFreqMap.clear();  // Reset for this configuration
+    stats = ExactSearchStats{};
+    if (options.shardCount == 0 || options.shardIndex >= options.shardCount) {
+        throw std::invalid_argument("Invalid shard " + std::to_string(options.shardIndex) + "/" +
+                                    std::to_string(options.shardCount));
+    }
+    if (n <= 0 || numCombs < n) {
+        // No set of n distinct vertex subsets exists
+        stats.optimal = true;
+        return {};
+    }
 
-            IndexType currentSize = 0;  // Track total edges needed for this configuration
+    // Standalone cost of every vertex subset and the permutation that achieves it
+    std::vector<IndexType> standaloneCost(static_cast<size_t>(numCombs),
+                                          std::numeric_limits<IndexType>::max());
+    std::vector<IndexType> bestPerm(static_cast<size_t>(numCombs), 0);
+    for (IndexType comb = 0; comb < numCombs; ++comb) {
+        for (IndexType perm = 0; perm < numPerms; ++perm) {
+            IndexType cost = 0;
+            for (const auto& edge : missingEdges.edges(perm, comb)) {
+                cost += edge.count;
+            }
+            if (cost < standaloneCost[comb]) {
+                standaloneCost[comb] = cost;
+                bestPerm[comb] = perm;
+            }
+        }
+    }
 
-            // Process each of the n copies
-            for (int i = 0; i < n; ++i) {
-                // Get missing edges for copy i (using permutation perms[i] and combination combs[i])
-                for (const auto& edge : allMissingEdges[perms[i]][combs[i]]) {
-                    // Update the maximum multiplicity needed for this edge across all copies
-                    IndexType& existingCount = edgeFreqMap[{edge.source, edge.destination}];
-                    if (existingCount == 0) {
-                        // First copy needs this edge
-                        existingCount = edge.count;
-                        currentSize += edge.count;
-                    } else if (edge.count > existingCount) {
-                        // Another copy needs MORE of this edge - increase multiplicity
-                        currentSize += (edge.count - existingCount);
-                        existingCount = edge.count;
-                    }
-                    // If edge.count <= existingCount, no change needed (sharing existing edges)
+    StatisticsRecorder<> recorder(options.statistics);
+
+    // Maximum multiplicity needed per edge (source, dest) across all n copies, as a dense
+    // |V_G|×|V_G| table plus the list of its nonzero cells. An embedding misses at most k²
+    // edges, so usedCells never grows past its reservation and evaluating a configuration
+    // allocates nothing.
+    const size_t rowLength = static_cast<size_t>(G.getVertexCount());
+    std::vector<uint8_t> edgeNeed(rowLength * rowLength, 0);
+    std::vector<size_t> usedCells;
+    usedCells.reserve(static_cast<size_t>(n) * static_cast<size_t>(P.getVertexCount()) *
+                      static_cast<size_t>(P.getVertexCount()));
+
+    // Max-merges copies 0..n-1 into edgeNeed and returns the total size, stopping early
+    // once it reaches `limit`
+    auto mergeCopies = [&](const std::vector<IndexType>& combs, auto&& permOf, IndexType limit) {
+        // Reset for this configuration
+        for (size_t cell : usedCells) {
+            edgeNeed[cell] = 0;
+        }
+        usedCells.clear();
+
+        IndexType currentSize = 0;  // Track total edges needed for this configuration
+
+        // Process each of the n copies
+        for (int i = 0; i < n; ++i) {
+            recorder.embeddingMerged();
+            // Get missing edges for copy i (using permutation permOf(i) and combination combs[i])
+            for (const auto& edge : missingEdges.edges(permOf(i), combs[i])) {
+                // Update the maximum multiplicity needed for this edge across all copies
+                const size_t cell = static_cast<size_t>(edge.source) * rowLength +
+                                    static_cast<size_t>(edge.destination);
+                uint8_t& existingCount = edgeNeed[cell];
+                if (existingCount == 0) {
+                    // First copy needs this edge
+                    usedCells.push_back(cell);
+                    existingCount = edge.count;
+                    currentSize += edge.count;
+                } else if (edge.count > existingCount) {
+                    // Another copy needs MORE of this edge - increase multiplicity
+                    currentSize += (edge.count - existingCount);
+                    existingCount = edge.count;
                 }
+                // If edge.count <= existingCount, no change needed (sharing existing edges)
+            }
 
-                // Early termination: if we've already exceeded the best known solution, stop
-                if (currentSize >= minSize) {
-                    break;
+            // Early termination: if we've already exceeded the best known solution, stop
+            if (currentSize >= limit) {
+                if (i + 1 < n) {
+                    recorder.configurationPrunedEarly();
                 }
+                break;
+            }
+        }
+        return currentSize;
+    };
+
+    std::vector<Edge<IndexType>> minimalExtension;  // Best solution found
+    auto saveExtension = [&] {
+        minimalExtension.clear();
+        minimalExtension.reserve(usedCells.size());
+        // Convert the used cells to an edge list
+        for (size_t cell : usedCells) {
+            minimalExtension.emplace_back(static_cast<IndexType>(cell / rowLength),
+                                          static_cast<IndexType>(cell % rowLength),
+                                          edgeNeed[cell]);
+        }
+    };
+
+    // Incumbent and global lower bound from the n cheapest subsets (ties by subset index)
+    std::vector<IndexType> cheapestCombs(static_cast<size_t>(numCombs));
+    std::iota(cheapestCombs.begin(), cheapestCombs.end(), IndexType{0});
+    std::nth_element(cheapestCombs.begin(), cheapestCombs.begin() + (n - 1), cheapestCombs.end(),
+                     [&](IndexType a, IndexType b) {
+                         return standaloneCost[a] != standaloneCost[b]
+                                    ? standaloneCost[a] < standaloneCost[b]
+                                    : a < b;
+                     });
+    const IndexType lowerBound = standaloneCost[cheapestCombs[n - 1]];
+    stats.lowerBound = static_cast<uint64_t>(lowerBound);
+    cheapestCombs.resize(static_cast<size_t>(n));
+    std::sort(cheapestCombs.begin(), cheapestCombs.end());
+
+    IndexType minSize = mergeCopies(  // Best size found
+        cheapestCombs, [&](int i) { return bestPerm[cheapestCombs[i]]; },
+        std::numeric_limits<IndexType>::max());
+    saveExtension();
+    recorder.incumbentImproved(searchStart, static_cast<uint64_t>(minSize), 0);
+
+    // Search order of the vertex subsets: order[rank] = subset. Without a warm start it is
+    // the identity, i.e. plain lexicographic order.
+    std::vector<IndexType> order(static_cast<size_t>(numCombs));
+    std::iota(order.begin(), order.end(), IndexType{0});
+
+    if (options.warmStart && *options.warmStart != AlgorithmType::EXACT) {
+        // The approximation only returns edges, and they are not guaranteed to host n copies.
+        // Every subset with an embedding that fits into G + approximate extension is
+        // "covered"; the n cheapest covered subsets form a configuration whose merged
+        // extension is a subset of the approximate one, so it is at most as expensive.
+        const auto approximate = run_algorithm(*options.warmStart, n, P, G);
+        std::vector<uint8_t> added(rowLength * rowLength, 0);
+        for (const auto& edge : approximate) {
+            uint8_t& cell = added[static_cast<size_t>(edge.source) * rowLength +
+                                  static_cast<size_t>(edge.destination)];
+            cell = std::max(cell, edge.count);
+        }
+
+        std::vector<IndexType> coverCost(static_cast<size_t>(numCombs),
+                                         std::numeric_limits<IndexType>::max());
+        std::vector<IndexType> coverPerm(static_cast<size_t>(numCombs), 0);
+        for (IndexType comb = 0; comb < numCombs; ++comb) {
+            for (IndexType perm = 0; perm < numPerms; ++perm) {
+                IndexType cost = 0;
+                bool covered = true;
+                for (const auto& edge : missingEdges.edges(perm, comb)) {
+                    if (edge.count > added[static_cast<size_t>(edge.source) * rowLength +
+                                           static_cast<size_t>(edge.destination)]) {
+                        covered = false;
+                        break;
+                    }
+                    cost += edge.count;
+                }
+                if (covered && cost < coverCost[comb]) {
+                    coverCost[comb] = cost;
+                    coverPerm[comb] = perm;
+                }
+            }
+        }
+
+        // Covered subsets are explored first (cheapest first), then the rest by standalone
+        // cost, so good configurations around the approximate solution are seen early
+        auto rank = [&](IndexType comb) {
+            const bool covered = coverCost[comb] != std::numeric_limits<IndexType>::max();
+            return std::make_tuple(!covered, covered ? coverCost[comb] : standaloneCost[comb],
+                                   comb);
+        };
+        std::sort(order.begin(), order.end(),
+                  [&](IndexType a, IndexType b) { return rank(a) < rank(b); });
+
+        const size_t coveredCount = static_cast<size_t>(
+            std::count_if(coverCost.begin(), coverCost.end(), [](IndexType cost) {
+                return cost != std::numeric_limits<IndexType>::max();
+            }));
+        if (coveredCount >= static_cast<size_t>(n)) {
+            const IndexType warmSize = mergeCopies(
+                order, [&](int i) { return coverPerm[order[i]]; }, minSize);
+            if (warmSize < minSize) {
+                minSize = warmSize;
+                saveExtension();
+                recorder.incumbentImproved(searchStart, static_cast<uint64_t>(minSize), 0);
+            }
+        }
+    }
+    stats.initialCost = static_cast<uint64_t>(minSize);
+
+    // Identifies the problem a checkpoint belongs to. The search order depends on the warm
+    // start, so it is part of the fingerprint.
+    const size_t patternBytes = static_cast<size_t>(P.getVertexCount()) * P.getVertexCount();
+    const size_t targetBytes = static_cast<size_t>(G.getVertexCount()) * G.getVertexCount();
+    const uint64_t problemSetup[] = {static_cast<uint64_t>(n), static_cast<uint64_t>(patternBytes),
+                                     static_cast<uint64_t>(targetBytes),
+                                     options.warmStart ? static_cast<uint64_t>(*options.warmStart) + 1
+                                                       : uint64_t{0}};
+    stats.fingerprint = binaryChecksum(reinterpret_cast<const uint8_t*>(problemSetup),
+                                       sizeof(problemSetup));
+    stats.fingerprint = binaryChecksum(P.data(), patternBytes, stats.fingerprint);
+    stats.fingerprint = binaryChecksum(G.data(), targetBytes, stats.fingerprint);
+    // A checkpoint also belongs to one shard
+    const bool sharded = options.shardCount > 1;
+    const uint64_t shard[] = {options.shardIndex, options.shardCount};
+    const uint64_t fingerprint =
+        sharded ? binaryChecksum(reinterpret_cast<const uint8_t*>(shard), sizeof(shard),
+                                 stats.fingerprint)
+                : stats.fingerprint;
+
+    // Resume from a checkpoint of the same problem: restore its incumbent (if it is better)
+    // and start at its position
+    std::vector<IndexType> resumeRanks;
+    std::vector<IndexType> resumePerms;
+    const bool checkpointing = !options.checkpointPath.empty();
+    if (checkpointing && options.resume) {
+        if (auto checkpoint = ExactCheckpoint<IndexType>::load(
+                options.checkpointPath, static_cast<uint64_t>(G.getVertexCount()))) {
+            if (checkpoint->fingerprint != fingerprint) {
+                throw std::runtime_error("Checkpoint belongs to a different problem: " +
+                                         options.checkpointPath.string());
+            }
+            bool valid = checkpoint->combination.size() == static_cast<size_t>(n) &&
+                         checkpoint->sequence.size() == static_cast<size_t>(n);
+            for (size_t i = 0; valid && i < checkpoint->combination.size(); ++i) {
+                valid = checkpoint->combination[i] < numCombs &&
+                        (i == 0 || checkpoint->combination[i - 1] < checkpoint->combination[i]) &&
+                        checkpoint->sequence[i] < numPerms;
+            }
+            if (!valid) {
+                throw std::runtime_error("Checkpoint position is out of range: " +
+                                         options.checkpointPath.string());
+            }
+
+            resumeRanks = std::move(checkpoint->combination);
+            resumePerms = std::move(checkpoint->sequence);
+            stats.nodesExplored = checkpoint->nodesExplored;
+            if (checkpoint->cost < static_cast<uint64_t>(minSize)) {
+                minSize = static_cast<IndexType>(checkpoint->cost);
+                minimalExtension = std::move(checkpoint->extension);
+                recorder.incumbentImproved(searchStart, checkpoint->cost, stats.nodesExplored);
+            }
+        }
+    }
+
+    // suffixMin[rank] = cheapest standalone cost of the subsets at order[rank..]. The first
+    // copy's rank never decreases, so once suffixMin of it reaches the incumbent, no
+    // remaining combination set can be cheaper.
+    std::vector<IndexType> suffixMin(static_cast<size_t>(numCombs) + 1,
+                                     std::numeric_limits<IndexType>::max());
+    for (IndexType rank = numCombs; rank > 0; --rank) {
+        suffixMin[rank - 1] = std::min(suffixMin[rank], standaloneCost[order[rank - 1]]);
+    }
+
+    // A limit beyond what the clock can represent from now on is no limit; converting it
+    // would overflow and put the deadline in the past. Half the range leaves room for the
+    // rounding of the conversion.
+    const double secondsLeftOnClock =
+        std::chrono::duration<double>(Clock::time_point::max() - searchStart).count();
+    const bool hasDeadline =
+        options.timeLimitSeconds > 0.0 && options.timeLimitSeconds < secondsLeftOnClock / 2;
+    const auto deadline =
+        hasDeadline ? searchStart + std::chrono::duration_cast<Clock::duration>(
+                                        std::chrono::duration<double>(options.timeLimitSeconds))
+                    : Clock::time_point::max();
+    const auto progressInterval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.progressIntervalSeconds));
+    auto nextProgress = searchStart + progressInterval;
+    const auto checkpointInterval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.checkpointIntervalSeconds));
+    auto nextCheckpoint = searchStart + checkpointInterval;
+
+    // Saves the frontier: `ranks` and `perms` (all zeros when null) are the next
+    // configuration that has not been evaluated yet
+    auto saveCheckpoint = [&](const std::vector<IndexType>& ranks,
+                              const std::vector<IndexType>* perms) {
+        ExactCheckpoint<IndexType> checkpoint;
+        checkpoint.fingerprint = fingerprint;
+        checkpoint.combination = ranks;
+        checkpoint.sequence =
+            perms != nullptr ? *perms : std::vector<IndexType>(static_cast<size_t>(n), 0);
+        checkpoint.nodesExplored = stats.nodesExplored;
+        checkpoint.lowerBound = static_cast<uint64_t>(lowerBound);
+        checkpoint.cost = static_cast<uint64_t>(minSize);
+        checkpoint.extension = minimalExtension;
+        checkpoint.save(options.checkpointPath);
+    };
+
+    auto reportProgress = [&](Clock::time_point now) {
+        const double elapsed = std::chrono::duration<double>(now - searchStart).count();
+        stats.cost = static_cast<uint64_t>(minSize);
+        *options.progress << "[exact] " << elapsed << " s, " << stats.nodesExplored
+                          << " nodes, incumbent " << stats.cost << ", lower bound "
+                          << stats.lowerBound << ", gap " << stats.gap() * 100.0 << "%"
+                          << std::endl;
+    };
+
+    // Reading the clock for every node would dominate small configurations, so the
+    // deadline, the stop flag and the timers are only checked every CHECK_INTERVAL nodes.
+    // (ranks, perms) is the configuration about to be evaluated.
+    constexpr uint64_t CHECK_INTERVAL = 1024;
+    uint64_t nodesSinceCheck = 0;
+    bool stopped = false;
+    auto checkClock = [&](const std::vector<IndexType>& ranks,
+                          const std::vector<IndexType>* perms) {
+        if (++nodesSinceCheck < CHECK_INTERVAL) {
+            return;
+        }
+        nodesSinceCheck = 0;
+        const auto now = Clock::now();
+        if ((hasDeadline && now >= deadline) ||
+            (options.stopRequested != nullptr && options.stopRequested->load())) {
+            stopped = true;
+        }
+        if (options.progress != nullptr && now >= nextProgress) {
+            reportProgress(now);
+            nextProgress = now + progressInterval;
+        }
+        if (checkpointing && (stopped || now >= nextCheckpoint)) {
+            saveCheckpoint(ranks, perms);
+            nextCheckpoint = now + checkpointInterval;
+        }
+    };
+
+    // The search runs on one thread; on the timeline it is split into one chunk per subset
+    // of the first copy
+    const bool tracing = Trace::enabled();
+    std::optional<TraceSpan> chunk;
+    int64_t chunkRank = -1;
+
+    // Try all m-combinations of vertex subsets (ensures n copies use different vertex sets)
+    std::vector<IndexType> combs(static_cast<size_t>(n));
+    for (const auto& ranks : CombinationRange<IndexType>(numCombs, n, std::move(resumeRanks))) {
+        // Nothing can beat the incumbent once it matches the global lower bound
+        if (stopped || minSize <= lowerBound || suffixMin[ranks[0]] >= minSize) {
+            break;
+        }
+        if (tracing && static_cast<int64_t>(ranks[0]) != chunkRank) {
+            chunkRank = static_cast<int64_t>(ranks[0]);
+            chunk.reset();
+            chunk.emplace("search chunk", "exact", "first rank", chunkRank);
+        }
+        // Only the first combination set of a resumed search starts mid-way
+        std::vector<IndexType> firstPerms = std::exchange(resumePerms, {});
+        if (sharded && exactShardOf(ranks, options.shardCount) != options.shardIndex) {
+            continue;
+        }
+        ++stats.nodesExplored;
+        recorder.combinationSetVisited();
+        checkClock(ranks, firstPerms.empty() ? nullptr : &firstPerms);
+
+        for (int i = 0; i < n; ++i) {
+            combs[i] = order[ranks[i]];
+        }
+
+        // Every copy needs at least its standalone cost
+        IndexType combsBound = 0;
+        for (int i = 0; i < n; ++i) {
+            combsBound = std::max(combsBound, standaloneCost[combs[i]]);
+        }
+        if (combsBound >= minSize) {
+            recorder.combinationSetPruned();
+            continue;
+        }
+
+        // For each combination of subsets, try all m-sequences of permutations
+        // (each copy can use a different ordering/mapping)
+        for (const auto& perms : SequenceRange<IndexType>(numPerms, n, std::move(firstPerms))) {
+            ++stats.nodesExplored;
+            checkClock(ranks, &perms);
+            if (stopped) {
+                break;
             }
+            recorder.configurationVisited();
+
+            const IndexType currentSize =
+                mergeCopies(combs, [&](int i) { return perms[i]; }, minSize);
 
             // If this configuration is better than the best known, save it
             if (currentSize < minSize) {
                 minSize = currentSize;
-                minimalExtension.clear();
-                minimalExtension.reserve(edgeFreqMap.size());
-                // Convert frequency map to edge list
-                for (const auto& [edge, count] : edgeFreqMap) {
-                    minimalExtension.emplace_back(edge.first, edge.second, count);
-                }
+                saveExtension();
+                recorder.incumbentImproved(searchStart, static_cast<uint64_t>(minSize),
+                                           stats.nodesExplored);
             }
         }
     }
 
+    chunk.reset();
+    recorder.flush();
+    stats.cost = static_cast<uint64_t>(minSize);
+    stats.optimal = !stopped || minSize <= lowerBound;
+    if (stats.optimal) {
+        stats.lowerBound = stats.cost;
+        // A finished search has nothing left to resume
+        if (checkpointing) {
+            std::error_code ignored;
+            std::filesystem::remove(options.checkpointPath, ignored);
+        }
+    }
     return minimalExtension;
 }
 
@@ -181,11 +620,80 @@ std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::findMinimalExtension(
  */
 template <typename IndexType>
 std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run(int n, Multigraph<IndexType>& P,
-                                                               Multigraph<IndexType>& G) {
-    // Phase 1: Compute missing edges for all possible embeddings
-    auto allMissingEdges = getAllMissingEdges(P, G);
-    // Phase 2: Find optimal combination of n embeddings
-    auto result = findMinimalExtension(n, P, G, allMissingEdges);
+                                                               Multigraph<IndexType>& G,
+                                                               PhaseTimings* timings) {
+    return run_exact(n, P, G, ExactOptions{}, nullptr, timings);
+}
+
+/**
+ * Exact Algorithm with a Time Limit
+ *
+ * Same search as run, but it can be stopped by options.timeLimitSeconds. It then
+ * returns the best extension found so far, which is always a valid extension: the
+ * search starts from the incumbent built in Phase 2 and only replaces it with cheaper
+ * configurations. `stats` receives the cost, the proven lower bound, the gap and
+ * whether the result is optimal.
+ *
+ * The deadline is only checked during Phase 2; Phase 1 always runs to completion.
+ *
+ * With options.storage == STREAMING there is no Phase 1: the search computes the missing
+ * edges of each vertex subset when it needs them and keeps as many subsets as fit into
+ * options.streamingCacheBytes (by the planner's average row size). With SPILLED, Phase 1
+ * writes the table to a scratch file in options.spillDirectory, deleted when the search
+ * returns, and the search reads it through the page cache. With COMPACT, Phase 1 builds
+ * the table in the encoding of CompactMissingEdges. The result is the same.
+ */
+template <typename IndexType>
+std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_exact(
+    int n, Multigraph<IndexType>& P, Multigraph<IndexType>& G, const ExactOptions& options,
+    ExactSearchStats* stats, PhaseTimings* timings) {
+    const auto searchStart = Clock::now();
+    auto phaseStart = searchStart;
+    ExactSearchStats searchStats;
+    std::vector<Edge<IndexType>> result;
+    if (options.storage == MissingEdgeStorage::STREAMING) {
+        // As many rows as fit into the budget on average, and at least one per copy
+        const uint64_t rowBytes = std::max<uint64_t>(planExact(n, P, G).streamingRowBytes, 1);
+        const uint64_t rows = std::max<uint64_t>(options.streamingCacheBytes / rowBytes,
+                                                 static_cast<uint64_t>(std::max(n, 1)));
+        StreamingMissingEdges<IndexType> missingEdges(
+            P, G, static_cast<size_t>(std::min<uint64_t>(rows, SIZE_MAX)));
+        recordPhase(timings ? &timings->phase1Ms : nullptr, phaseStart);
+        result = findMinimalExtensionFrom(n, P, G, missingEdges, options, searchStart,
+                                          searchStats);
+    } else if (options.storage == MissingEdgeStorage::SPILLED) {
+        if (options.spillDirectory.empty()) {
+            throw std::invalid_argument("Spilling the Phase 1 table needs a spill directory");
+        }
+        // Unique per run, so concurrent searches can share the directory
+        std::ostringstream name;
+        name << "subgraphs-phase1-" << std::hex << std::random_device{}() << std::random_device{}()
+             << ".bin";
+        SpilledMissingEdges<IndexType> missingEdges(P, G, options.spillDirectory / name.str());
+        recordPhase(timings ? &timings->phase1Ms : nullptr, phaseStart);
+        result = findMinimalExtensionFrom(n, P, G, missingEdges, options, searchStart,
+                                          searchStats);
+    } else if (options.storage == MissingEdgeStorage::COMPACT) {
+        // Rows are decoded about once per combination set, so one per copy suffices
+        CompactMissingEdges<IndexType> missingEdges(P, G, static_cast<size_t>(std::max(n, 1)));
+        recordPhase(timings ? &timings->phase1Ms : nullptr, phaseStart);
+        result = findMinimalExtensionFrom(n, P, G, missingEdges, options, searchStart,
+                                          searchStats);
+    } else {
+        // Phase 1: Compute missing edges for all possible embeddings
+        auto allMissingEdges = getAllMissingEdges(P, G);
+        recordPhase(timings ? &timings->phase1Ms : nullptr, phaseStart);
+        StatisticsRecorder<> recorder(options.statistics);
+        recorder.phase1Table(allMissingEdges);
+        recorder.flush();
+        // Phase 2: Find optimal combination of n embeddings
+        result = findMinimalExtension(n, P, G, allMissingEdges, options, searchStart,
+                                      searchStats);
+    }
+    recordPhase(timings ? &timings->phase2Ms : nullptr, phaseStart);
+    if (stats != nullptr) {
+        *stats = searchStats;
+    }
     return result;
 }
 
@@ -217,8 +725,11 @@ std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run(int n, Multigraph
  */
 template <typename IndexType>
 std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_approx_v2(int n, Multigraph<IndexType>& P,
-                                                                Multigraph<IndexType>& G, HeuristicType heuristic) {
+                                                                Multigraph<IndexType>& G, HeuristicType heuristic,
+                                                                PhaseTimings* timings) {
+    TraceSpan span("run_approx_v2", "approx2", "heuristic", static_cast<int64_t>(heuristic));
     IndexType k = P.getVertexCount();
+    auto phaseStart = Clock::now();
 
     auto currentG = G.getAdjacencyMatrix();  // Working copy of G's adjacency matrix
     std::unordered_map<std::pair<IndexType, IndexType>, IndexType> result{};  // Accumulated edges to add
@@ -233,11 +744,16 @@ std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_approx_v2(int n,
         // Lower cost = better match between P vertex i and G vertex subset[j]
         auto weightMatrix = Heuristic<IndexType>::createWeightMatrix(P, tempG, subset, heuristic);
         currentG = tempG.getAdjacencyMatrix();
+        recordPhase(timings ? &timings->phase1Ms : nullptr, phaseStart);
 
         // Solve assignment problem: find optimal bijection from P vertices to subset vertices
         HungarianAlgorithm hungarian;
         std::vector<int> assignment;  // assignment[i] = which subset vertex P vertex i maps to
-        hungarian.Solve(weightMatrix, assignment);
+        {
+            TraceSpan solveSpan("HungarianAlgorithm::Solve", "approx2", "k", k);
+            hungarian.Solve(weightMatrix, assignment);
+        }
+        recordPhase(timings ? &timings->assignmentMs : nullptr, phaseStart);
 
         // Apply the mapping: add edges to G to support this copy of P
         for (IndexType u = 0; u < k; ++u) {
@@ -267,6 +783,7 @@ std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_approx_v2(int n,
                 }
             }
         }
+        recordPhase(timings ? &timings->mergeMs : nullptr, phaseStart);
 
         // Stop after processing n combinations
         if (++i >= n) {
@@ -280,6 +797,7 @@ std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_approx_v2(int n,
     for (const auto& [edge, count] : result) {
         edges.emplace_back(edge.first, edge.second, count);
     }
+    recordPhase(timings ? &timings->mergeMs : nullptr, phaseStart);
     return edges;
 }
 
@@ -292,89 +810,134 @@ std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_approx_v2(int n,
  *    the mapping to cover all vertices of P
  * 2. Compute the cost (number of edges to add) for each complete mapping
  * 3. Select n best non-overlapping mappings
- * 4. Merge the cost matrices using max operation (edges can be shared between copies)
+ * 4. Merge their missing edges using max operation (edges can be shared between copies)
  * 5. Return the edges that need to be added to G
  *
- * Time Complexity: O(|V_P|² × |V_G|² × |V_P|)
- * Space Complexity: O(|V_P| × |V_G| × |V_G|²) for storing all cost matrices
+ * Phase 1 evaluates the |V_P| × |V_G| seeds on up to threadCount threads. Results are
+ * written to fixed slots, so the output is identical to a serial run. With one thread, or
+ * fewer than MIN_PARALLEL_SEEDS seeds, no pool is created and the seeds run on the
+ * calling thread; callers that are themselves pool tasks (portfolio, batch) pass 1.
+ *
+ * The greedy extension keeps a running cost for every candidate pair and updates it
+ * incrementally when a pair is added, so each extension step is O(|V_P| × |V_G|).
+ *
+ * Time Complexity: O(|V_P|³ × |V_G|²)
+ * Space Complexity: O(|V_P| × |V_G| × |V_P|²) for the per-seed missing-edge lists,
+ *                   plus one O(|V_G|²) buffer for the final merge
  */
 template <typename IndexType>
 std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_approx_v1(int n, Multigraph<IndexType>& P,
-                                                                Multigraph<IndexType>& G) {
+                                                                Multigraph<IndexType>& G,
+                                                                PhaseTimings* timings,
+                                                                size_t threadCount) {
+    TraceSpan span("run_approx_v1", "approx1");
+    // Below this many seeds the pool start-up costs more than the seeds themselves
+    constexpr size_t MIN_PARALLEL_SEEDS = 64;
     const IndexType k = P.getVertexCount();
     const IndexType numG = G.getVertexCount();
 
+    // No injective mapping of P into G exists, so there is nothing to extend
+    if (numG < k) {
+        return {};
+    }
+
     // SeedConfiguration stores a complete mapping from P vertices to G vertices
-    // along with its cost and the required edge additions
+    // along with its cost and the required edge additions. Only the (at most k²)
+    // missing edges are kept, not a dense numG×numG matrix per seed.
     struct SeedConfiguration {
-        IndexType totalCost;                              // Total number of edges to add
-        std::vector<std::vector<uint8_t>> costMatrix;     // Matrix of edge counts to add at each position
-        std::unordered_map<IndexType, IndexType> mapping; // P vertex -> G vertex mapping
-
-        // Sort configurations by total cost (lower is better)
-        bool operator<(const SeedConfiguration& other) const {
-            return totalCost < other.totalCost;
-        }
+        IndexType totalCost;                       // Total number of edges to add
+        std::vector<IndexType> mapping;            // mapping[p] = G vertex for P vertex p
+        std::vector<Edge<IndexType>> missingEdges; // Edges to add (G vertices, multiplicity)
     };
 
-    // Store all possible seed configurations (one for each seed pair)
-    std::vector<SeedConfiguration> allConfigurations;
-    allConfigurations.reserve(k * numG);
+    // Store all possible seed configurations (one for each seed pair).
+    // Seed (u1, u2) always lands at index u1 * numG + u2, so the list has the same order
+    // as a serial run no matter how the seeds are distributed across threads.
+    const size_t seedCount = static_cast<size_t>(k) * static_cast<size_t>(numG);
+    std::vector<SeedConfiguration> allConfigurations(seedCount);
+
+    auto phaseStart = Clock::now();
 
     // ===== PHASE 1: Generate all seed configurations =====
-    // Try every possible seed pair: (u1 from P, u2 from G)
-    for (IndexType u1 = 0; u1 < k; ++u1) {
-        for (IndexType u2 = 0; u2 < numG; ++u2) {
+    // Every seed pair (u1 from P, u2 from G) is independent, so contiguous blocks of seeds
+    // are evaluated in parallel. Each block owns its scratch arrays and reuses them
+    // for all of its seeds.
+    auto evaluateSeeds = [&](size_t seedBegin, size_t seedEnd) {
+        TraceSpan blockSpan("seed block", "approx1", "first seed",
+                            static_cast<int64_t>(seedBegin));
+        const size_t rowLength = static_cast<size_t>(numG);
+
+        // Mapping from P vertices to G vertices for the current seed (mapping[p] = g)
+        std::vector<IndexType> mapping(static_cast<size_t>(k));
+
+        // Track which vertices have been mapped
+        std::vector<bool> mappedP(static_cast<size_t>(k));  // Mapped P vertices
+        std::vector<bool> mappedG(rowLength);               // Mapped G vertices
+
+        // Running cost of every candidate pair: candidateCost[v1 * numG + v2] = sum of
+        // missing edges between (v1, v2) and all already-mapped pairs. It is updated
+        // incrementally whenever a pair is added, instead of being recomputed from the
+        // whole mapping for every candidate.
+        std::vector<IndexType> candidateCost(static_cast<size_t>(k) * rowLength);
 
-            // Cost matrix: costMatrix[i][j] = number of edges to add between G vertices i and j
-            std::vector<std::vector<uint8_t>> costMatrix(numG, std::vector<uint8_t>(numG, 0));
+        // Adds the pair (mapped1 -> mapped2) and charges its edge deficits to every
+        // still-unmapped candidate pair (v1, v2)
+        auto addPair = [&](IndexType mapped1, IndexType mapped2) {
+            mapping[mapped1] = mapped2;
+            mappedP[mapped1] = true;
+            mappedG[mapped2] = true;
 
-            // Mapping from P vertices to G vertices for this seed
-            std::unordered_map<IndexType, IndexType> mapping;
+            for (IndexType v1 = 0; v1 < k; ++v1) {
+                if (mappedP[v1]) continue;  // Skip already mapped P vertices
 
-            // Track which vertices have been mapped
-            std::unordered_set<IndexType> mappedP;  // Mapped P vertices
-            std::unordered_set<IndexType> mappedG;  // Mapped G vertices
+                // P edges between the new pair and v1 are the same for every v2
+                const uint8_t pEdges1 = P.getEdges(mapped1, v1);
+                const uint8_t pEdges2 = P.getEdges(v1, mapped1);
+                if (pEdges1 == 0 && pEdges2 == 0) continue;  // Nothing can be missing
+
+                IndexType* costRow = &candidateCost[static_cast<size_t>(v1) * rowLength];
+                for (IndexType v2 = 0; v2 < numG; ++v2) {
+                    if (mappedG[v2]) continue;  // Skip already mapped G vertices
+
+                    // Forward edges: from the newly mapped vertex to the candidate vertex
+                    const uint8_t gEdges1 = G.getEdges(mapped2, v2);
+                    costRow[v2] += (pEdges1 > gEdges1) ? (pEdges1 - gEdges1) : 0;
+
+                    // Backward edges: from the candidate vertex to the newly mapped vertex
+                    const uint8_t gEdges2 = G.getEdges(v2, mapped2);
+                    costRow[v2] += (pEdges2 > gEdges2) ? (pEdges2 - gEdges2) : 0;
+                }
+            }
+        };
+
+        for (size_t seed = seedBegin; seed < seedEnd; ++seed) {
+            const IndexType u1 = static_cast<IndexType>(seed / rowLength);
+            const IndexType u2 = static_cast<IndexType>(seed % rowLength);
+
+            std::fill(mappedP.begin(), mappedP.end(), false);
+            std::fill(mappedG.begin(), mappedG.end(), false);
+            std::fill(candidateCost.begin(), candidateCost.end(), IndexType{0});
 
             // Initialize with the seed pair
-            mapping[u1] = u2;
-            mappedP.insert(u1);
-            mappedG.insert(u2);
+            addPair(u1, u2);
 
             // ===== Greedy Extension: Map remaining P vertices to G vertices =====
-            // Continue until all P vertices are mapped
-            while (mappedP.size() < static_cast<size_t>(k)) {
+            // Each step adds one pair, so k - 1 steps map every P vertex (numG >= k)
+            for (IndexType step = 1; step < k; ++step) {
                 IndexType bestV1 = -1;  // Best unmapped P vertex to add next
                 IndexType bestV2 = -1;  // Best unmapped G vertex to map it to
                 IndexType minCost = std::numeric_limits<IndexType>::max();
 
-                // Try all combinations of unmapped P and G vertices
+                // Pick the cheapest unmapped pair (first one in (v1, v2) order on ties)
                 for (IndexType v1 = 0; v1 < k; ++v1) {
-                    if (mappedP.count(v1)) continue;  // Skip already mapped P vertices
+                    if (mappedP[v1]) continue;
 
+                    const IndexType* costRow = &candidateCost[static_cast<size_t>(v1) * rowLength];
                     for (IndexType v2 = 0; v2 < numG; ++v2) {
-                        if (mappedG.count(v2)) continue;  // Skip already mapped G vertices
-
-                        // Compute cost of adding (v1 -> v2) to the current mapping
-                        // Cost = sum of missing edges between (v1, v2) and all already-mapped pairs
-                        IndexType cost = 0;
-                        for (const auto& [mapped1, mapped2] : mapping) {
-                            // Check edges in both directions (directed graph)
-
-                            // Forward edges: from already-mapped vertex to the new vertex
-                            const uint8_t pEdges1 = P.getEdges(mapped1, v1);
-                            const uint8_t gEdges1 = G.getEdges(mapped2, v2);
-                            cost += (pEdges1 > gEdges1) ? (pEdges1 - gEdges1) : 0;
-
-                            // Backward edges: from the new vertex to already-mapped vertex
-                            const uint8_t pEdges2 = P.getEdges(v1, mapped1);
-                            const uint8_t gEdges2 = G.getEdges(v2, mapped2);
-                            cost += (pEdges2 > gEdges2) ? (pEdges2 - gEdges2) : 0;
-                        }
+                        if (mappedG[v2]) continue;
 
-                        // Keep track of the pair with minimum cost
-                        if (cost < minCost) {
-                            minCost = cost;
+                        if (costRow[v2] < minCost) {
+                            minCost = costRow[v2];
                             bestV1 = v1;
                             bestV2 = v2;
                         }
@@ -382,22 +945,20 @@ std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_approx_v1(int n,
                 }
 
                 // Add the best pair to the mapping
-                if (bestV1 != static_cast<IndexType>(-1)) {
-                    mapping[bestV1] = bestV2;
-                    mappedP.insert(bestV1);
-                    mappedG.insert(bestV2);
-                }
+                addPair(bestV1, bestV2);
             }
 
-            // ===== Compute the complete cost matrix for this mapping =====
-            IndexType totalCost = 0;
+            // ===== Compute the missing edges for this mapping =====
+            SeedConfiguration& config = allConfigurations[seed];
+            config.totalCost = 0;
+            config.mapping = mapping;
 
             // For each pair of P vertices (i, j), check if we need to add edges
             // between their mapped G vertices
             for (IndexType i = 0; i < k; ++i) {
                 for (IndexType j = 0; j < k; ++j) {
-                    const IndexType gi = mapping[i];  // G vertex mapped from P vertex i
-                    const IndexType gj = mapping[j];  // G vertex mapped from P vertex j
+                    const IndexType gi = config.mapping[i];  // G vertex mapped from P vertex i
+                    const IndexType gj = config.mapping[j];  // G vertex mapped from P vertex j
 
                     const uint8_t pEdges = P.getEdges(i, j);  // Edges in P
                     const uint8_t gEdges = G.getEdges(gi, gj); // Edges in G
@@ -405,68 +966,96 @@ std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_approx_v1(int n,
                     // If P has more edges than G, we need to add the difference
                     if (pEdges > gEdges) {
                         const uint8_t missing = pEdges - gEdges;
-                        costMatrix[gi][gj] = missing;
-                        totalCost += missing;
+                        config.missingEdges.emplace_back(gi, gj, missing);
+                        config.totalCost += missing;
                     }
                 }
             }
-
-            // Store this complete configuration
-            allConfigurations.push_back({totalCost, std::move(costMatrix), std::move(mapping)});
         }
+    };
+    if (threadCount > 1 && seedCount >= MIN_PARALLEL_SEEDS) {
+        ThreadPool pool(threadCount);
+        pool.parallelFor(seedCount, pool.size() * 4, evaluateSeeds);
+    } else {
+        evaluateSeeds(0, seedCount);
     }
+    recordPhase(timings ? &timings->phase1Ms : nullptr, phaseStart);
 
     // ===== PHASE 2: Select n best non-overlapping configurations =====
+    // Configurations are ordered by (total cost, seed index), which is a total order, so
+    // the selection does not depend on the sort algorithm. Only as many configurations as
+    // needed are pulled from a heap instead of sorting all |V_P| × |V_G| of them.
+    auto costsMore = [&allConfigurations](size_t a, size_t b) {
+        const IndexType costA = allConfigurations[a].totalCost;
+        const IndexType costB = allConfigurations[b].totalCost;
+        return costA != costB ? costA > costB : a > b;
+    };
+    std::vector<size_t> candidates(seedCount);
+    std::iota(candidates.begin(), candidates.end(), size_t{0});
+    std::make_heap(candidates.begin(), candidates.end(), costsMore);
 
-    // Sort all configurations by total cost (ascending)
-    std::sort(allConfigurations.begin(), allConfigurations.end());
+    // Every mapping uses exactly |V_P| distinct G vertices, so two configurations overlap
+    // completely iff their sorted vertex sets are equal. The sets of the selected
+    // configurations are stored back to back, and a flat open-addressing table (linear
+    // probing, at most half full) maps their 64-bit hashes to them. A hash hit is confirmed
+    // against the stored set, so colliding hashes never drop a configuration.
+    const size_t setSize = static_cast<size_t>(k);
+    const size_t maxSelected = std::min(static_cast<size_t>(std::max(n, 0)), seedCount);
+    std::vector<IndexType> selectedSets;
+    selectedSets.reserve(maxSelected * setSize);
+    std::vector<uint64_t> selectedHashes;
+    selectedHashes.reserve(maxSelected);
+    const size_t tableMask = std::bit_ceil(2 * maxSelected + 1) - 1;
+    std::vector<size_t> hashTable(tableMask + 1, 0); // Selected index + 1, 0 = empty slot
 
-    std::vector<SeedConfiguration> selectedConfigs;
-    selectedConfigs.reserve(n);
+    std::vector<const SeedConfiguration*> selectedConfigs;
+    selectedConfigs.reserve(maxSelected);
 
-    // Greedily select configurations, ensuring no vertex overlap
-    for (const auto& config : allConfigurations) {
-        bool usesDifferentSubset = true;
+    // Greedily select the cheapest configurations whose subset of G vertices is new
+    std::vector<IndexType> vertexSet;
+    auto heapEnd = candidates.end();
+    while (selectedConfigs.size() < maxSelected && heapEnd != candidates.begin()) {
+        std::pop_heap(candidates.begin(), heapEnd, costsMore);
+        --heapEnd;
+        const SeedConfiguration& config = allConfigurations[*heapEnd];
 
-        // Check if this configuration uses the exact same subset of G vertices than any other configuration
-        for (const auto& selected : selectedConfigs) {
-            usesDifferentSubset = false;
-            for (const auto& [p_vertex, g_vertex] : config.mapping) {
-                bool found = false;
-                for (const auto& [p_vertex2, g_vertex2] : selected.mapping) {
-                    if (g_vertex == g_vertex2) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    usesDifferentSubset = true;
-                    break;
-                }
+        vertexSet = config.mapping;
+        std::sort(vertexSet.begin(), vertexSet.end());
+        const uint64_t hash = hashVertexSequence(vertexSet);
+        size_t slot = static_cast<size_t>(hash) & tableMask;
+        bool used = false;
+        for (; hashTable[slot] != 0; slot = (slot + 1) & tableMask) {
+            const size_t selected = hashTable[slot] - 1;
+            const auto selectedSet =
+                selectedSets.begin() + static_cast<std::ptrdiff_t>(selected * setSize);
+            if (selectedHashes[selected] == hash &&
+                std::equal(vertexSet.begin(), vertexSet.end(), selectedSet)) {
+                used = true;
+                break;
             }
-            if (!usesDifferentSubset) break;
         }
-
-        // If this configuration uses a different subset of G vertices than any other configuration, add it to the selected set
-        if (usesDifferentSubset) {
-            selectedConfigs.push_back(config);
-            if (static_cast<int>(selectedConfigs.size()) >= n) {
-                break;  // Found enough configurations
-            }
+        if (!used) {
+            hashTable[slot] = selectedConfigs.size() + 1;
+            selectedHashes.push_back(hash);
+            selectedSets.insert(selectedSets.end(), vertexSet.begin(), vertexSet.end());
+            selectedConfigs.push_back(&config);
         }
     }
+    recordPhase(timings ? &timings->phase2Ms : nullptr, phaseStart);
 
-    // ===== PHASE 3: Merge cost matrices using max operation =====
+    // ===== PHASE 3: Merge missing edges using max operation =====
     // Key insight: Multiple copies can share edges. If copy A needs 3 edges between
     // vertices (i,j) and copy B needs 2 edges between the same vertices, we only
     // need to add max(3,2) = 3 edges total, not 3+2 = 5 edges.
-    std::vector<std::vector<uint8_t>> finalMatrix(numG, std::vector<uint8_t>(numG, 0));
-    for (const auto& config : selectedConfigs) {
-        for (IndexType i = 0; i < numG; ++i) {
-            for (IndexType j = 0; j < numG; ++j) {
-                // Take the maximum edge count needed across all selected configurations
-                finalMatrix[i][j] = std::max(finalMatrix[i][j], config.costMatrix[i][j]);
-            }
+    // Only the selected configurations are merged, into a single dense row-major buffer.
+    const size_t rowLength = static_cast<size_t>(numG);
+    std::vector<uint8_t> finalMatrix(rowLength * rowLength, 0);
+    for (const SeedConfiguration* config : selectedConfigs) {
+        for (const auto& edge : config->missingEdges) {
+            // Take the maximum edge count needed across all selected configurations
+            uint8_t& cell = finalMatrix[static_cast<size_t>(edge.source) * rowLength +
+                                        static_cast<size_t>(edge.destination)];
+            cell = std::max(cell, edge.count);
         }
     }
 
@@ -474,14 +1063,134 @@ std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_approx_v1(int n,
     std::vector<Edge<IndexType>> result;
     for (IndexType i = 0; i < numG; ++i) {
         for (IndexType j = 0; j < numG; ++j) {
-            if (finalMatrix[i][j] > 0) {
-                result.emplace_back(i, j, finalMatrix[i][j]);
+            const uint8_t count = finalMatrix[static_cast<size_t>(i) * rowLength + j];
+            if (count > 0) {
+                result.emplace_back(i, j, count);
             }
         }
     }
+    recordPhase(timings ? &timings->mergeMs : nullptr, phaseStart);
+
+    return result;
+}
+
+/**
+ * Portfolio Mode: Run Every Approximation Concurrently and Keep the Best
+ *
+ * Runs approx1 and approx2 with every HeuristicType as independent tasks on a
+ * pool of up to threadCount threads. All members only read P and G (approx2 works on
+ * its own copy of G's adjacency matrix), so the graphs are shared between threads
+ * without locking. With threadCount == 1 (e.g. inside a batch job, which already runs
+ * on a pool) the members run one after another on the calling thread.
+ *
+ * The extension with the smallest total cost is returned. Ties are resolved in
+ * member order (approx1 first, then heuristics in HeuristicType order), so the
+ * result does not depend on thread scheduling.
+ *
+ * If `report` is provided, it receives one entry per member (in member order)
+ * with the member's extension, its cost and its wall-clock time.
+ *
+ * Wall-clock time: max over members instead of their sum (given enough cores)
+ */
+template <typename IndexType>
+std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_portfolio(
+    int n, Multigraph<IndexType>& P, Multigraph<IndexType>& G,
+    std::vector<PortfolioEntry<IndexType>>* report, size_t threadCount) {
+    // Times a single member and packs its outcome into a PortfolioEntry
+    auto timed = [](std::string name, auto&& solve) {
+        PortfolioEntry<IndexType> entry;
+        entry.name = std::move(name);
+        const auto start = Clock::now();
+        entry.extension = solve();
+        const auto end = Clock::now();
+        entry.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        entry.cost = extensionCost(entry.extension);
+        return entry;
+    };
+
+    // Members in member order
+    std::vector<std::function<PortfolioEntry<IndexType>()>> members;
+    members.reserve(ALL_HEURISTICS.size() + 1);
+    members.push_back(
+        [&] { return timed("approx1", [&] { return run_approx_v1(n, P, G, nullptr, 1); }); });
+    for (HeuristicType heuristic : ALL_HEURISTICS) {
+        members.push_back([&, heuristic] {
+            return timed("approx2_" + std::string(heuristicName(heuristic)),
+                         [&] { return run_approx_v2(n, P, G, heuristic); });
+        });
+    }
+
+    std::vector<PortfolioEntry<IndexType>> entries;
+    entries.reserve(members.size());
+    if (threadCount <= 1) {
+        for (auto& member : members) {
+            entries.push_back(member());
+        }
+    } else {
+        ThreadPool pool(std::min(threadCount, members.size()));
+        std::vector<std::future<PortfolioEntry<IndexType>>> futures;
+        futures.reserve(members.size());
+        for (auto& member : members) {
+            futures.push_back(pool.submit(member));
+        }
+        for (auto& future : futures) {
+            entries.push_back(future.get());
+        }
+    }
+
+    // Pick the cheapest member (first one wins on ties)
+    size_t best = 0;
+    for (size_t i = 1; i < entries.size(); ++i) {
+        if (entries[i].cost < entries[best].cost) {
+            best = i;
+        }
+    }
 
+    std::vector<Edge<IndexType>> result = entries[best].extension;
+    if (report != nullptr) {
+        *report = std::move(entries);
+    }
     return result;
 }
 
+template <typename IndexType>
+std::vector<Edge<IndexType>> SubgraphAlgorithm<IndexType>::run_algorithm(
+    AlgorithmType algorithm, int n, Multigraph<IndexType>& P, Multigraph<IndexType>& G,
+    HeuristicType heuristic, PhaseTimings* timings, size_t threadCount) {
+    switch (algorithm) {
+        case AlgorithmType::EXACT:
+            return run(n, P, G, timings);
+        case AlgorithmType::APPROX1:
+            return run_approx_v1(n, P, G, timings, threadCount);
+        case AlgorithmType::APPROX2:
+            return run_approx_v2(n, P, G, heuristic, timings);
+        case AlgorithmType::PORTFOLIO:
+            return run_portfolio(n, P, G, nullptr, threadCount);
+    }
+    return {};
+}
+
+/**
+ * Total cost of an extension: the number of edges it adds, counting multiplicities.
+ */
+template <typename IndexType>
+uint64_t SubgraphAlgorithm<IndexType>::extensionCost(const std::vector<Edge<IndexType>>& extension) {
+    uint64_t cost = 0;
+    for (const auto& edge : extension) {
+        cost += edge.count;
+    }
+    return cost;
+}
+
+template <typename IndexType>
+void SubgraphAlgorithm<IndexType>::recordPhase(double* phase, Clock::time_point& start) {
+    if (phase == nullptr) {
+        return;
+    }
+    const auto now = Clock::now();
+    *phase += std::chrono::duration<double, std::milli>(now - start).count();
+    start = now;
+}
+
 } // namespace Subgraphs
 
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace Subgraphs {
@@ -15,6 +16,8 @@ template <typename IndexType = int64_t> class CombinationIterator {
     using reference = const value_type&;
 
     CombinationIterator(IndexType n, IndexType k, bool end = false);
+    // Starts at `start` (k strictly increasing values below n) instead of {0, 1, ..., k-1}
+    CombinationIterator(IndexType n, IndexType k, const std::vector<IndexType>& start);
 
     const std::vector<IndexType>& operator*() const;
     CombinationIterator& operator++();
@@ -33,6 +36,8 @@ template <typename IndexType = int64_t> class CombinationIterator {
 template <typename IndexType = int64_t> class CombinationRange {
   public:
     CombinationRange(IndexType n, IndexType k);
+    // Range of the combinations from `first` (inclusive) to the last one
+    CombinationRange(IndexType n, IndexType k, std::vector<IndexType> first);
 
     CombinationIterator<IndexType> begin() const;
     CombinationIterator<IndexType> end() const;
@@ -40,6 +45,7 @@ template <typename IndexType = int64_t> class CombinationRange {
   private:
     IndexType n;
     IndexType k;
+    std::vector<IndexType> start; // Empty: the first combination
 };
 
 } // namespace Subgraphs
@@ -14,6 +14,15 @@ CombinationIterator<IndexType>::CombinationIterator(IndexType n, IndexType k, bo
     }
 }
 
+template <typename IndexType>
+CombinationIterator<IndexType>::CombinationIterator(IndexType n, IndexType k,
+                                                    const std::vector<IndexType>& start)
+    : combination(start), n(n), k(k), isEnd(false) {
+    if (k > n || k <= 0 || static_cast<IndexType>(start.size()) != k) {
+        isEnd = true;
+    }
+}
+
 template <typename IndexType>
 const std::vector<IndexType>& CombinationIterator<IndexType>::operator*() const {
     return combination;
@@ -72,8 +81,17 @@ template <typename IndexType>
 CombinationRange<IndexType>::CombinationRange(IndexType n, IndexType k) : n(n), k(k) {
 }
 
+template <typename IndexType>
+CombinationRange<IndexType>::CombinationRange(IndexType n, IndexType k,
+                                              std::vector<IndexType> first)
+    : n(n), k(k), start(std::move(first)) {
+}
+
 template <typename IndexType>
 CombinationIterator<IndexType> CombinationRange<IndexType>::begin() const {
+    if (!start.empty()) {
+        return CombinationIterator<IndexType>(n, k, start);
+    }
     return CombinationIterator<IndexType>(n, k, false);
 }
 
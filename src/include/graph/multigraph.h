@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include "combination_iterator.h"
@@ -17,8 +18,16 @@ template <typename IndexType = int64_t> class Multigraph {
   public:
     Multigraph() = delete;
     explicit Multigraph(std::vector<std::vector<uint8_t>>&& adjMatrix);
+    Multigraph(IndexType vertices, std::vector<uint8_t>&& adjMatrix);
+    // Read-only view of a row-major matrix owned by `owner` (e.g. a mapped file).
+    // The matrix is copied on the first addEdges call.
+    Multigraph(IndexType vertices, IndexType edges, const uint8_t* adjMatrix,
+               std::shared_ptr<const void> owner);
     explicit Multigraph(IndexType vertices);
     Multigraph(const Multigraph& other);
+    Multigraph(Multigraph&& other) noexcept;
+    Multigraph& operator=(const Multigraph& other);
+    Multigraph& operator=(Multigraph&& other) noexcept;
 
     ~Multigraph() = default;
 
@@ -52,11 +61,18 @@ template <typename IndexType = int64_t> class Multigraph {
 
     void printAdjacencyMatrix() const;
     std::vector<std::vector<uint8_t>> getAdjacencyMatrix() const;
+    const uint8_t* data() const;
+    bool isView() const;
 
   private:
     IndexType vertexCount{};
     IndexType edgeCount{};
-    std::vector<std::vector<uint8_t>> adjMatrix;
+    std::vector<uint8_t> adjMatrix; // Row-major: adjMatrix[source * vertexCount + destination]
+    std::shared_ptr<const void> storageOwner; // Set while the matrix is external (a view)
+    const uint8_t* matrixData{nullptr};       // adjMatrix.data() or the external matrix
+
+    size_t index(IndexType source, IndexType destination) const;
+    void bindStorage(const uint8_t* externalData);
 };
 
 } // namespace Subgraphs
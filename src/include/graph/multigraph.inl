@@ -3,37 +3,111 @@ namespace Subgraphs {
 
 template <typename IndexType>
 Multigraph<IndexType>::Multigraph(std::vector<std::vector<uint8_t>>&& adjMatrix)
-    : adjMatrix(std::move(adjMatrix)) {
-    vertexCount = static_cast<IndexType>(this->adjMatrix.size());
+    : vertexCount(static_cast<IndexType>(adjMatrix.size())) {
+    const size_t n = adjMatrix.size();
+    this->adjMatrix.reserve(n * n);
+    for (const auto& row : adjMatrix) {
+        this->adjMatrix.insert(this->adjMatrix.end(), row.begin(), row.end());
+    }
+    matrixData = this->adjMatrix.data();
     edgeCount = 0;
-    for (const auto& row : this->adjMatrix) {
-        for (uint8_t weight : row) {
-            edgeCount += static_cast<IndexType>(weight);
-        }
+    for (uint8_t weight : this->adjMatrix) {
+        edgeCount += static_cast<IndexType>(weight);
     }
 }
 
+template <typename IndexType>
+Multigraph<IndexType>::Multigraph(IndexType vertices, std::vector<uint8_t>&& adjMatrix)
+    : vertexCount(vertices), adjMatrix(std::move(adjMatrix)) {
+    matrixData = this->adjMatrix.data();
+    edgeCount = 0;
+    for (uint8_t weight : this->adjMatrix) {
+        edgeCount += static_cast<IndexType>(weight);
+    }
+}
+
+template <typename IndexType>
+Multigraph<IndexType>::Multigraph(IndexType vertices, IndexType edges, const uint8_t* adjMatrix,
+                                  std::shared_ptr<const void> owner)
+    : vertexCount(vertices), edgeCount(edges), storageOwner(std::move(owner)),
+      matrixData(adjMatrix) {
+}
+
 template <typename IndexType>
 Multigraph<IndexType>::Multigraph(IndexType vertices)
     : vertexCount(vertices), edgeCount(0),
-      adjMatrix(static_cast<size_t>(vertices),
-                std::vector<uint8_t>(static_cast<size_t>(vertices), 0)) {
+      adjMatrix(static_cast<size_t>(vertices) * static_cast<size_t>(vertices), 0),
+      matrixData(adjMatrix.data()) {
 }
 
+// Views share the external matrix and its owner; owning graphs point at their own vector
 template <typename IndexType>
 Multigraph<IndexType>::Multigraph(const Multigraph& other)
-    : vertexCount(other.vertexCount), edgeCount(other.edgeCount), adjMatrix(other.adjMatrix) {
+    : vertexCount(other.vertexCount), edgeCount(other.edgeCount), adjMatrix(other.adjMatrix),
+      storageOwner(other.storageOwner) {
+    bindStorage(other.matrixData);
+}
+
+template <typename IndexType>
+Multigraph<IndexType>::Multigraph(Multigraph&& other) noexcept
+    : vertexCount(other.vertexCount), edgeCount(other.edgeCount),
+      adjMatrix(std::move(other.adjMatrix)), storageOwner(std::move(other.storageOwner)) {
+    bindStorage(other.matrixData);
+    other.matrixData = other.adjMatrix.data();
+}
+
+template <typename IndexType>
+Multigraph<IndexType>& Multigraph<IndexType>::operator=(const Multigraph& other) {
+    if (this != &other) {
+        vertexCount = other.vertexCount;
+        edgeCount = other.edgeCount;
+        adjMatrix = other.adjMatrix;
+        storageOwner = other.storageOwner;
+        bindStorage(other.matrixData);
+    }
+    return *this;
+}
+
+template <typename IndexType>
+Multigraph<IndexType>& Multigraph<IndexType>::operator=(Multigraph&& other) noexcept {
+    if (this != &other) {
+        vertexCount = other.vertexCount;
+        edgeCount = other.edgeCount;
+        adjMatrix = std::move(other.adjMatrix);
+        storageOwner = std::move(other.storageOwner);
+        bindStorage(other.matrixData);
+        other.matrixData = other.adjMatrix.data();
+    }
+    return *this;
+}
+
+template <typename IndexType>
+void Multigraph<IndexType>::bindStorage(const uint8_t* externalData) {
+    matrixData = storageOwner ? externalData : adjMatrix.data();
+}
+
+template <typename IndexType>
+size_t Multigraph<IndexType>::index(IndexType source, IndexType destination) const {
+    return static_cast<size_t>(source) * static_cast<size_t>(vertexCount) +
+           static_cast<size_t>(destination);
 }
 
 template <typename IndexType>
 void Multigraph<IndexType>::addEdges(IndexType source, IndexType destination, uint8_t count) {
+    if (storageOwner) {
+        // Copy-on-write: detach from the external matrix before the first modification
+        const size_t n = static_cast<size_t>(vertexCount);
+        adjMatrix.assign(matrixData, matrixData + n * n);
+        storageOwner.reset();
+        matrixData = adjMatrix.data();
+    }
     edgeCount += count;
-    adjMatrix[source][destination] += count;
+    adjMatrix[index(source, destination)] += count;
 }
 
 template <typename IndexType>
 uint8_t Multigraph<IndexType>::getEdges(IndexType source, IndexType destination) const {
-    return adjMatrix[source][destination];
+    return matrixData[index(source, destination)];
 }
 
 template <typename IndexType>
@@ -44,15 +118,15 @@ Degree<IndexType> Multigraph<IndexType>::getDegree(IndexType v) const {
 template <typename IndexType> IndexType Multigraph<IndexType>::getInDegree(IndexType v) const {
     IndexType degree = 0;
     for (IndexType i = 0; i < vertexCount; ++i) {
-        degree += static_cast<IndexType>(adjMatrix[i][v]);
+        degree += static_cast<IndexType>(matrixData[index(i, v)]);
     }
     return degree;
 }
 
 template <typename IndexType> IndexType Multigraph<IndexType>::getOutDegree(IndexType v) const {
     IndexType degree = 0;
-    for (uint8_t weight : adjMatrix[v]) {
-        degree += static_cast<IndexType>(weight);
+    for (IndexType i = 0; i < vertexCount; ++i) {
+        degree += static_cast<IndexType>(matrixData[index(v, i)]);
     }
     return degree;
 }
@@ -89,8 +163,8 @@ std::vector<std::pair<IndexType, uint8_t>>
 Multigraph<IndexType>::getNeighbors(IndexType v) const {
     std::vector<std::pair<IndexType, uint8_t>> neighbors;
     for (IndexType i = 0; i < vertexCount; ++i) {
-        if (adjMatrix[v][i] > 0 || adjMatrix[i][v] > 0) {
-            neighbors.emplace_back(i, adjMatrix[v][i] + adjMatrix[i][v]);
+        if (matrixData[index(v, i)] > 0 || matrixData[index(i, v)] > 0) {
+            neighbors.emplace_back(i, matrixData[index(v, i)] + matrixData[index(i, v)]);
         }
     }
     return neighbors;
@@ -101,8 +175,8 @@ std::vector<std::pair<IndexType, uint8_t>>
 Multigraph<IndexType>::getInNeighbors(IndexType v) const {
     std::vector<std::pair<IndexType, uint8_t>> neighbors;
     for (IndexType i = 0; i < vertexCount; ++i) {
-        if (adjMatrix[i][v] > 0) {
-            neighbors.emplace_back(i, adjMatrix[i][v]);
+        if (matrixData[index(i, v)] > 0) {
+            neighbors.emplace_back(i, matrixData[index(i, v)]);
         }
     }
     return neighbors;
@@ -113,8 +187,8 @@ std::vector<std::pair<IndexType, uint8_t>>
 Multigraph<IndexType>::getOutNeighbors(IndexType v) const {
     std::vector<std::pair<IndexType, uint8_t>> neighbors;
     for (IndexType i = 0; i < vertexCount; ++i) {
-        if (adjMatrix[v][i] > 0) {
-            neighbors.emplace_back(i, adjMatrix[v][i]);
+        if (matrixData[index(v, i)] > 0) {
+            neighbors.emplace_back(i, matrixData[index(v, i)]);
         }
     }
     return neighbors;
@@ -180,15 +254,31 @@ template <typename IndexType> bool Multigraph<IndexType>::operator<(const Multig
 
 template <typename IndexType>
 std::vector<std::vector<uint8_t>> Multigraph<IndexType>::getAdjacencyMatrix() const {
-    return adjMatrix;
+    const size_t n = static_cast<size_t>(vertexCount);
+    std::vector<std::vector<uint8_t>> matrix;
+    matrix.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        const uint8_t* rowBegin = matrixData + i * n;
+        matrix.emplace_back(rowBegin, rowBegin + n);
+    }
+    return matrix;
+}
+
+template <typename IndexType> const uint8_t* Multigraph<IndexType>::data() const {
+    return matrixData;
+}
+
+template <typename IndexType> bool Multigraph<IndexType>::isView() const {
+    return storageOwner != nullptr;
 }
 
 template <typename IndexType> void Multigraph<IndexType>::printAdjacencyMatrix() const {
-    int n = static_cast<int>(adjMatrix.size());
+    int n = static_cast<int>(vertexCount);
     std::cout << n << "\n";
     for (int i = 0; i < n; ++i) {
         for (int j = 0; j < n; ++j) {
-            std::cout << static_cast<int>(adjMatrix[i][j]);
+            const uint8_t weight = getEdges(static_cast<IndexType>(i), static_cast<IndexType>(j));
+            std::cout << static_cast<int>(weight);
             if (j + 1 < n)
                 std::cout << " ";
         }
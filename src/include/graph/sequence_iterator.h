@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace Subgraphs {
@@ -14,6 +15,8 @@ template <typename IndexType = uint64_t> class SequenceIterator {
     using reference = const value_type&;
 
     SequenceIterator(IndexType maxValue, IndexType length, bool isEnd = false);
+    // Starts at `start` (length values below maxValue) instead of all zeros
+    SequenceIterator(IndexType maxValue, IndexType length, const std::vector<IndexType>& start);
 
     reference operator*() const;
     pointer operator->() const;
@@ -36,6 +39,8 @@ template <typename IndexType = uint64_t> class SequenceIterator {
 template <typename IndexType = uint64_t> class SequenceRange {
   public:
     SequenceRange(IndexType maxValue, IndexType length);
+    // Range of the sequences from `first` (inclusive) to the last one
+    SequenceRange(IndexType maxValue, IndexType length, std::vector<IndexType> first);
 
     SequenceIterator<IndexType> begin() const;
     SequenceIterator<IndexType> end() const;
@@ -43,6 +48,7 @@ template <typename IndexType = uint64_t> class SequenceRange {
   private:
     IndexType maxValue;
     IndexType length;
+    std::vector<IndexType> start; // Empty: all zeros
 };
 
 } // namespace Subgraphs
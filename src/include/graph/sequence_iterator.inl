@@ -9,6 +9,15 @@ SequenceIterator<IndexType>::SequenceIterator(IndexType maxValue, IndexType leng
     }
 }
 
+template <typename IndexType>
+SequenceIterator<IndexType>::SequenceIterator(IndexType maxValue, IndexType length,
+                                              const std::vector<IndexType>& start)
+    : maxValue(maxValue), length(length), current(start), isEnd(false) {
+    if (maxValue == 0 || length == 0 || static_cast<IndexType>(start.size()) != length) {
+        this->isEnd = true;
+    }
+}
+
 template <typename IndexType>
 typename SequenceIterator<IndexType>::reference SequenceIterator<IndexType>::operator*() const {
     return current;
@@ -71,7 +80,16 @@ SequenceRange<IndexType>::SequenceRange(IndexType maxValue, IndexType length)
     : maxValue(maxValue), length(length) {
 }
 
+template <typename IndexType>
+SequenceRange<IndexType>::SequenceRange(IndexType maxValue, IndexType length,
+                                        std::vector<IndexType> first)
+    : maxValue(maxValue), length(length), start(std::move(first)) {
+}
+
 template <typename IndexType> SequenceIterator<IndexType> SequenceRange<IndexType>::begin() const {
+    if (!start.empty()) {
+        return SequenceIterator<IndexType>(maxValue, length, start);
+    }
     return SequenceIterator<IndexType>(maxValue, length, false);
 }
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Subgraphs {
+
+// Heap activity over a span of time (see AllocationScope)
+struct AllocationCounts {
+    uint64_t allocations{};   // Calls to operator new
+    uint64_t deallocations{}; // Calls to operator delete (non-null pointers)
+    uint64_t bytes{};         // Bytes requested from operator new
+    uint64_t peakBytes{};     // Highest live heap size above the level at the start
+};
+
+/**
+ * Allocation Counting
+ *
+ * The counters are only fed when an executable links the subgraphs_alloc_hooks target,
+ * which replaces the global operator new/delete (src/instrumentation/allocation_hooks.cpp).
+ * Everything else, the CLI included, keeps the default allocator and pays nothing;
+ * hooksInstalled() tells the two apart.
+ *
+ * The counters are process-wide, so allocations of worker threads count too. Measure phases
+ * with AllocationScope:
+ *
+ *     AllocationScope scope;
+ *     auto table = SubgraphAlgorithm<T>::getAllMissingEdges(P, G);
+ *     AllocationCounts phase1 = scope.counts();
+ */
+class AllocationTracker {
+  public:
+    AllocationTracker() = delete;
+
+    static bool hooksInstalled() { return installed.load(std::memory_order_relaxed); }
+
+    // Called by the hooks
+    static void markInstalled() { installed.store(true, std::memory_order_relaxed); }
+    static void recordAllocation(size_t size);
+    static void recordDeallocation(size_t size);
+
+  private:
+    friend class AllocationScope;
+
+    static void raisePeak(uint64_t live);
+
+    static inline std::atomic<bool> installed{false};
+    static inline std::atomic<uint64_t> allocations{0};
+    static inline std::atomic<uint64_t> deallocations{0};
+    static inline std::atomic<uint64_t> bytes{0};
+    static inline std::atomic<uint64_t> liveBytes{0};
+    static inline std::atomic<uint64_t> peakLiveBytes{0};
+};
+
+// Heap activity since construction. Scopes may nest; an inner scope does not hide the peak
+// from an outer one.
+class AllocationScope {
+  public:
+    AllocationScope();
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+    ~AllocationScope();
+
+    AllocationCounts counts() const;
+
+  private:
+    uint64_t startAllocations;
+    uint64_t startDeallocations;
+    uint64_t startBytes;
+    uint64_t startLiveBytes;
+    uint64_t outerPeak; // Peak of the enclosing scope, restored on destruction
+};
+
+} // namespace Subgraphs
+
+#include "allocation_tracker.inl"
@@ -0,0 +1,47 @@
+namespace Subgraphs {
+
+inline void AllocationTracker::raisePeak(uint64_t live) {
+    uint64_t current = peakLiveBytes.load(std::memory_order_relaxed);
+    while (current < live &&
+           !peakLiveBytes.compare_exchange_weak(current, live, std::memory_order_relaxed)) {
+    }
+}
+
+inline void AllocationTracker::recordAllocation(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    const uint64_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    raisePeak(live);
+}
+
+inline void AllocationTracker::recordDeallocation(size_t size) {
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+    liveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+inline AllocationScope::AllocationScope()
+    : startAllocations(AllocationTracker::allocations.load(std::memory_order_relaxed)),
+      startDeallocations(AllocationTracker::deallocations.load(std::memory_order_relaxed)),
+      startBytes(AllocationTracker::bytes.load(std::memory_order_relaxed)),
+      startLiveBytes(AllocationTracker::liveBytes.load(std::memory_order_relaxed)),
+      // The peak restarts at the current live size
+      outerPeak(AllocationTracker::peakLiveBytes.exchange(startLiveBytes,
+                                                           std::memory_order_relaxed)) {}
+
+inline AllocationScope::~AllocationScope() {
+    AllocationTracker::raisePeak(outerPeak);
+}
+
+inline AllocationCounts AllocationScope::counts() const {
+    AllocationCounts counts;
+    counts.allocations =
+        AllocationTracker::allocations.load(std::memory_order_relaxed) - startAllocations;
+    counts.deallocations =
+        AllocationTracker::deallocations.load(std::memory_order_relaxed) - startDeallocations;
+    counts.bytes = AllocationTracker::bytes.load(std::memory_order_relaxed) - startBytes;
+    const uint64_t peak = AllocationTracker::peakLiveBytes.load(std::memory_order_relaxed);
+    counts.peakBytes = peak > startLiveBytes ? peak - startLiveBytes : 0;
+    return counts;
+}
+
+} // namespace Subgraphs
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "../algorithms/heuristic.h"
+#include "../algorithms/subgraph_algorithm.h"
+#include "../graph/multigraph.h"
+#include "graph_loader.h"
+#include "json_output.h"
+#include "thread_pool.h"
+
+namespace Subgraphs {
+
+// One (file, n, algorithm, heuristic) job of a batch run
+struct BatchJob {
+    std::string id;                 // Echoed back in the result, if set
+    std::filesystem::path file;     // Graph pair to load (any GraphLoader format)
+    int subgraphs{1};               // Number of pattern copies
+    AlgorithmType algorithm{AlgorithmType::EXACT};
+    HeuristicType heuristic{HeuristicType::DEGREE_DIFFERENCE};
+};
+
+/**
+ * Batch Mode: Solve Many Graph Pairs in One Process
+ *
+ * Jobs are read line by line from a manifest (or stdin) and run on a thread pool as soon
+ * as they are read. Each line is either
+ * - a JSON object: {"file": "g.txt", "n": 2, "algorithm": "approx2", "heuristic": "degree",
+ *   "id": "optional label"}, or
+ * - the positional CLI arguments: g.txt [n] [algorithm] [heuristic]
+ * Blank lines and lines starting with '#' are ignored.
+ *
+ * A file is loaded once and shared (read-only) by all queued jobs that use it, and dropped
+ * when the last of them finishes (see GraphCache). One JSON line per job is written to the
+ * output as soon as the job finishes, so results arrive in completion order; the "job"
+ * field holds the manifest line number.
+ */
+template <typename IndexType = int64_t> class BatchRunner {
+  public:
+    BatchRunner() = delete;
+
+    // Runs all jobs from `jobs`, streaming results to `results`. Returns the number of
+    // failed jobs (including malformed manifest lines).
+    static size_t run(std::istream& jobs, std::ostream& results,
+                      size_t threadCount = ThreadPool::defaultThreadCount());
+
+    // Parses one manifest line; returns std::nullopt for blank and comment lines.
+    // Throws std::runtime_error for malformed lines.
+    static std::optional<BatchJob> parseJob(std::string_view line);
+
+  private:
+    using GraphPair = std::pair<Multigraph<IndexType>, Multigraph<IndexType>>;
+
+    // Loads a file at most once while queued jobs refer to it, even when several jobs ask
+    // for it concurrently. Each job retains its file when it is queued and releases it when
+    // it finishes; a file no job refers to any more is dropped, except for the most recently
+    // released one, which is kept in case the next manifest lines use it again.
+    class GraphCache {
+      public:
+        void retain(const std::filesystem::path& file);
+
+        // Returns the loaded pair and whether this call had to load it
+        std::pair<std::shared_ptr<GraphPair>, bool> get(const std::filesystem::path& file);
+
+        void release(const std::filesystem::path& file);
+
+      private:
+        struct Entry {
+            std::shared_future<std::shared_ptr<GraphPair>> graphs; // Invalid until requested
+            size_t pendingJobs{0};                                // Queued or running
+        };
+
+        std::mutex mutex;
+        std::map<std::string, Entry> entries;
+        std::optional<std::string> idleKey; // The one kept entry with no pending jobs
+    };
+
+    static std::string runJob(const BatchJob& job, size_t lineNumber, GraphCache& cache,
+                              bool& failed);
+
+    static std::string errorResult(size_t lineNumber, const std::string& message);
+
+    static std::optional<BatchJob> parseJsonJob(std::string_view line);
+};
+
+} // namespace Subgraphs
+
+#include "batch_runner.inl"
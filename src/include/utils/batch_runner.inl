@@ -0,0 +1,396 @@
+#include <charconv>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace Subgraphs {
+
+template <typename IndexType>
+void BatchRunner<IndexType>::GraphCache::retain(const std::filesystem::path& file) {
+    const std::string key = file.lexically_normal().string();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries[key].pendingJobs++ == 0 && idleKey == key) {
+        idleKey.reset();
+    }
+}
+
+template <typename IndexType>
+std::pair<std::shared_ptr<typename BatchRunner<IndexType>::GraphPair>, bool>
+BatchRunner<IndexType>::GraphCache::get(const std::filesystem::path& file) {
+    const std::string key = file.lexically_normal().string();
+
+    std::promise<std::shared_ptr<GraphPair>> promise;
+    std::shared_future<std::shared_ptr<GraphPair>> future;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& entry = entries[key];
+        if (!entry.graphs.valid()) {
+            entry.graphs = promise.get_future().share();
+            owner = true;
+        }
+        future = entry.graphs;
+    }
+
+    // The first job asking for a file loads it; the others wait on the shared future.
+    // A failed load is cached too, so every job using the file reports the same error.
+    // The loading job already holds a batch thread, so it parses the file by itself.
+    if (owner) {
+        try {
+            promise.set_value(
+                std::make_shared<GraphPair>(GraphLoader<IndexType>::loadFromFile(file, 1)));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+    return {future.get(), owner};
+}
+
+template <typename IndexType>
+void BatchRunner<IndexType>::GraphCache::release(const std::filesystem::path& file) {
+    const std::string key = file.lexically_normal().string();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end() || --it->second.pendingJobs > 0) {
+        return;
+    }
+    // Jobs still holding the pair keep it alive through their shared_ptr
+    if (idleKey) {
+        entries.erase(*idleKey);
+    }
+    idleKey = key;
+}
+
+template <typename IndexType>
+size_t BatchRunner<IndexType>::run(std::istream& jobs, std::ostream& results,
+                                   size_t threadCount) {
+    GraphCache cache;
+    std::mutex outputMutex;
+    std::atomic<size_t> failures{0};
+
+    // Whole lines are written under the lock and flushed, so consumers can follow along
+    auto emit = [&](const std::string& line) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        results << line << '\n';
+        results.flush();
+    };
+
+    {
+        ThreadPool pool(threadCount);
+        std::vector<std::future<void>> pending;
+
+        std::string line;
+        size_t lineNumber = 0;
+        while (std::getline(jobs, line)) {
+            ++lineNumber;
+            std::optional<BatchJob> job;
+            try {
+                job = parseJob(line);
+            } catch (const std::exception& e) {
+                ++failures;
+                emit(errorResult(lineNumber, e.what()));
+                continue;
+            }
+            if (!job) {
+                continue;
+            }
+
+            cache.retain(job->file);
+            pending.push_back(pool.submit([&, job = std::move(*job), lineNumber] {
+                bool failed = false;
+                std::string result = runJob(job, lineNumber, cache, failed);
+                cache.release(job.file);
+                if (failed) {
+                    ++failures;
+                }
+                emit(result);
+            }));
+        }
+
+        for (auto& job : pending) {
+            job.get();
+        }
+    }
+
+    return failures;
+}
+
+template <typename IndexType>
+std::string BatchRunner<IndexType>::runJob(const BatchJob& job, size_t lineNumber,
+                                           GraphCache& cache, bool& failed) {
+    using Clock = std::chrono::steady_clock;
+    auto milliseconds = [](Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    std::string out = "{\"job\":" + std::to_string(lineNumber);
+    if (!job.id.empty()) {
+        out += ",\"id\":";
+        appendJsonString(out, job.id);
+    }
+    out += ",\"file\":";
+    appendJsonString(out, job.file.string());
+    out += ",\"n\":" + std::to_string(job.subgraphs);
+    out += ",\"algorithm\":\"" + std::string(algorithmName(job.algorithm)) + "\"";
+    if (job.algorithm == AlgorithmType::APPROX2) {
+        out += ",\"heuristic\":\"" + std::string(heuristicName(job.heuristic)) + "\"";
+    }
+
+    const auto loadStart = Clock::now();
+    double loadMs = 0.0;
+    try {
+        auto [graphs, loaded] = cache.get(job.file);
+        const auto loadEnd = Clock::now();
+        loadMs = milliseconds(loadStart, loadEnd);
+
+        // The algorithms only read P and G, so the cached pair is shared between jobs
+        Multigraph<IndexType>& patternGraph = graphs->first;
+        Multigraph<IndexType>& targetGraph = graphs->second;
+        if (job.subgraphs < 1 ||
+            targetGraph.combinationsCount(patternGraph.getVertexCount()) <
+                static_cast<uint64_t>(job.subgraphs)) {
+            throw std::runtime_error("Target graph does not have enough vertices to host " +
+                                     std::to_string(job.subgraphs) +
+                                     " copies of the pattern graph");
+        }
+
+        const auto solveStart = Clock::now();
+        const std::vector<Edge<IndexType>> extension = SubgraphAlgorithm<IndexType>::run_algorithm(
+            job.algorithm, job.subgraphs, patternGraph, targetGraph, job.heuristic, nullptr, 1);
+        const auto solveEnd = Clock::now();
+
+        out += ",\"status\":\"success\"";
+        const uint64_t cost = SubgraphAlgorithm<IndexType>::extensionCost(extension);
+        out += ",\"cost\":" + std::to_string(cost);
+        out += ",\"extension\":";
+        appendJsonExtension(out, extension);
+        out += ",\"cached\":";
+        out += loaded ? "false" : "true";
+        out += ",\"load_ms\":" + std::to_string(loadMs);
+        out += ",\"solve_ms\":" + std::to_string(milliseconds(solveStart, solveEnd));
+    } catch (const std::exception& e) {
+        failed = true;
+        out += ",\"status\":\"error\",\"error\":";
+        appendJsonString(out, e.what());
+    }
+    out += "}";
+    return out;
+}
+
+template <typename IndexType>
+std::string BatchRunner<IndexType>::errorResult(size_t lineNumber, const std::string& message) {
+    std::string out = "{\"job\":" + std::to_string(lineNumber) + ",\"status\":\"error\",\"error\":";
+    appendJsonString(out, message);
+    out += "}";
+    return out;
+}
+
+template <typename IndexType>
+std::optional<BatchJob> BatchRunner<IndexType>::parseJob(std::string_view line) {
+    const size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos || line[first] == '#') {
+        return std::nullopt;
+    }
+    line.remove_prefix(first);
+    if (line.front() == '{') {
+        return parseJsonJob(line);
+    }
+
+    // Positional form, same order as the command line: file [n] [algorithm] [heuristic]
+    std::vector<std::string_view> tokens;
+    while (!line.empty()) {
+        const size_t begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos) {
+            break;
+        }
+        const size_t end = line.find_first_of(" \t\r", begin);
+        tokens.push_back(line.substr(begin, end == std::string_view::npos ? end : end - begin));
+        line.remove_prefix(end == std::string_view::npos ? line.size() : end);
+    }
+    if (tokens.size() > 4) {
+        throw std::runtime_error("Too many fields in job line");
+    }
+
+    BatchJob job;
+    job.file = std::string(tokens[0]);
+    if (tokens.size() >= 2) {
+        const auto [ptr, error] =
+            std::from_chars(tokens[1].data(), tokens[1].data() + tokens[1].size(), job.subgraphs);
+        if (error != std::errc{} || ptr != tokens[1].data() + tokens[1].size()) {
+            throw std::runtime_error("Invalid number of subgraphs: " + std::string(tokens[1]));
+        }
+    }
+    if (tokens.size() >= 3) {
+        auto algorithm = parseAlgorithm(tokens[2]);
+        if (!algorithm) {
+            throw std::runtime_error("Unknown algorithm: " + std::string(tokens[2]));
+        }
+        job.algorithm = *algorithm;
+    }
+    if (tokens.size() >= 4) {
+        auto heuristic = parseHeuristic(tokens[3]);
+        if (!heuristic) {
+            throw std::runtime_error("Unknown heuristic: " + std::string(tokens[3]));
+        }
+        job.heuristic = *heuristic;
+    }
+    return job;
+}
+
+/**
+ * Minimal parser for one flat JSON object with string and integer values, which is all a
+ * job needs. Unknown keys are ignored; nested values are rejected.
+ */
+template <typename IndexType>
+std::optional<BatchJob> BatchRunner<IndexType>::parseJsonJob(std::string_view line) {
+    size_t pos = 1; // Past '{'
+    auto fail = [](const std::string& message) -> void {
+        throw std::runtime_error("Malformed JSON job: " + message);
+    };
+    auto skipSpace = [&] {
+        while (pos < line.size() &&
+               (line[pos] == ' ' || line[pos] == '\t' || line[pos] == '\r' || line[pos] == '\n')) {
+            ++pos;
+        }
+    };
+    auto parseString = [&] {
+        std::string value;
+        ++pos; // Past the opening quote
+        while (pos < line.size() && line[pos] != '"') {
+            char c = line[pos++];
+            if (c == '\\') {
+                if (pos >= line.size()) {
+                    break;
+                }
+                const char escaped = line[pos++];
+                switch (escaped) {
+                    case 'n':
+                        c = '\n';
+                        break;
+                    case 't':
+                        c = '\t';
+                        break;
+                    case 'r':
+                        c = '\r';
+                        break;
+                    case 'b':
+                        c = '\b';
+                        break;
+                    case 'f':
+                        c = '\f';
+                        break;
+                    case '"':
+                    case '\\':
+                    case '/':
+                        c = escaped;
+                        break;
+                    default:
+                        fail(std::string("unsupported escape \\") + escaped);
+                }
+            }
+            value += c;
+        }
+        if (pos >= line.size()) {
+            fail("unterminated string");
+        }
+        ++pos; // Past the closing quote
+        return value;
+    };
+
+    BatchJob job;
+    bool hasFile = false;
+    skipSpace();
+    if (pos < line.size() && line[pos] == '}') {
+        fail("missing \"file\"");
+    }
+    while (pos < line.size()) {
+        skipSpace();
+        if (pos >= line.size() || line[pos] != '"') {
+            fail("expected a key");
+        }
+        const std::string key = parseString();
+        skipSpace();
+        if (pos >= line.size() || line[pos] != ':') {
+            fail("expected ':' after \"" + key + "\"");
+        }
+        ++pos;
+        skipSpace();
+        if (pos >= line.size()) {
+            fail("missing value for \"" + key + "\"");
+        }
+
+        std::string text;
+        std::optional<long long> number;
+        if (line[pos] == '"') {
+            text = parseString();
+        } else if (line[pos] == '{' || line[pos] == '[') {
+            fail("nested value for \"" + key + "\"");
+        } else {
+            const size_t end = line.find_first_of(",} \t\r", pos);
+            text = std::string(line.substr(pos, end == std::string_view::npos ? end : end - pos));
+            pos = end == std::string_view::npos ? line.size() : end;
+            long long value = 0;
+            const auto [ptr, error] =
+                std::from_chars(text.data(), text.data() + text.size(), value);
+            if (error == std::errc{} && ptr == text.data() + text.size()) {
+                number = value;
+            }
+        }
+
+        if (key == "file") {
+            job.file = text;
+            hasFile = true;
+        } else if (key == "id") {
+            job.id = text;
+        } else if (key == "n" || key == "subgraphs") {
+            if (!number && !text.empty()) {
+                // Also accept numbers written as strings
+                long long value = 0;
+                const auto [ptr, error] =
+                    std::from_chars(text.data(), text.data() + text.size(), value);
+                if (error == std::errc{} && ptr == text.data() + text.size()) {
+                    number = value;
+                }
+            }
+            if (!number || *number < 0 || *number > std::numeric_limits<int>::max()) {
+                throw std::runtime_error("Invalid number of subgraphs: " + text);
+            }
+            job.subgraphs = static_cast<int>(*number);
+        } else if (key == "algorithm") {
+            auto algorithm = parseAlgorithm(text);
+            if (!algorithm) {
+                throw std::runtime_error("Unknown algorithm: " + text);
+            }
+            job.algorithm = *algorithm;
+        } else if (key == "heuristic") {
+            auto heuristic = parseHeuristic(text);
+            if (!heuristic) {
+                throw std::runtime_error("Unknown heuristic: " + text);
+            }
+            job.heuristic = *heuristic;
+        }
+
+        skipSpace();
+        if (pos < line.size() && line[pos] == ',') {
+            ++pos;
+            continue;
+        }
+        if (pos < line.size() && line[pos] == '}') {
+            ++pos;
+            skipSpace();
+            if (pos != line.size()) {
+                fail("trailing characters after the object");
+            }
+            if (!hasFile) {
+                fail("missing \"file\"");
+            }
+            return job;
+        }
+        fail("expected ',' or '}'");
+    }
+    fail("unterminated object");
+    return std::nullopt;
+}
+
+} // namespace Subgraphs
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Subgraphs {
+
+/**
+ * On-disk layout of the binary graph-pair format (".sgb")
+ *
+ * [BinaryGraphHeader][padding][payload of graph 0][padding][payload of graph 1]
+ *
+ * All integers are little-endian. Each payload starts at a multiple of
+ * BINARY_PAYLOAD_ALIGNMENT bytes from the beginning of the file, so a memory-mapped
+ * dense payload can be used in place as a Multigraph's row-major adjacency matrix.
+ *
+ * Payload encodings:
+ * - Dense:  vertexCount² bytes, row-major edge multiplicities
+ * - Sparse: one BinarySparseEdge per non-zero matrix entry
+ *
+ * The checksum covers both payloads followed by the header with its checksum field zeroed
+ * (see binaryFileChecksum), so a corrupted vertex or edge count is caught as well.
+ */
+inline constexpr char BINARY_MAGIC[8] = {'S', 'U', 'B', 'G', 'R', 'A', 'P', 'H'};
+inline constexpr uint32_t BINARY_FORMAT_VERSION = 2;
+inline constexpr size_t BINARY_PAYLOAD_ALIGNMENT = 64;
+
+enum class BinaryEncoding : uint32_t {
+    DENSE = 0,
+    SPARSE = 1,
+};
+
+struct BinaryGraphSection {
+    uint64_t vertexCount;
+    uint64_t edgeCount;     // Sum of all multiplicities
+    uint64_t payloadOffset; // From the beginning of the file
+    uint64_t payloadSize;   // In bytes
+    uint32_t encoding;      // BinaryEncoding
+    uint32_t reserved;
+};
+
+struct BinaryGraphHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    BinaryGraphSection graphs[2];
+    uint64_t checksum;
+    uint8_t reserved[24];
+};
+
+struct BinarySparseEdge {
+    uint32_t source;
+    uint32_t destination;
+    uint8_t count;
+    uint8_t reserved[3];
+};
+
+static_assert(sizeof(BinaryGraphHeader) == 128, "Binary header layout must not change");
+static_assert(sizeof(BinarySparseEdge) == 12, "Sparse edge layout must not change");
+
+/**
+ * 64-bit FNV-1a variant over 8-byte words (trailing bytes one at a time). Hashing a
+ * word per step keeps verification close to memory bandwidth for large payloads.
+ */
+inline uint64_t binaryChecksum(const uint8_t* data, size_t size,
+                               uint64_t hash = 14695981039346656037ULL) {
+    constexpr uint64_t prime = 1099511628211ULL;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ data[i]) * prime;
+    }
+    return hash;
+}
+
+/**
+ * Finishes a file checksum: `payloadHash` chains binaryChecksum over both payloads, and the
+ * header is hashed last with its own checksum field zeroed.
+ */
+inline uint64_t binaryFileChecksum(BinaryGraphHeader header, uint64_t payloadHash) {
+    header.checksum = 0;
+    return binaryChecksum(reinterpret_cast<const uint8_t*>(&header), sizeof(header),
+                          payloadHash);
+}
+
+inline size_t alignPayloadOffset(size_t offset) {
+    return (offset + BINARY_PAYLOAD_ALIGNMENT - 1) / BINARY_PAYLOAD_ALIGNMENT *
+           BINARY_PAYLOAD_ALIGNMENT;
+}
+
+} // namespace Subgraphs
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include "../graph/edge.h"
+
+namespace Subgraphs {
+
+/**
+ * Exploration Frontier of an Exact Search
+ *
+ * Written periodically by SubgraphAlgorithm::run_exact when ExactOptions::checkpointPath
+ * is set, and read back with ExactOptions::resume. The position is stored as the next
+ * combination set and permutation sequence to explore (their element vectors, not
+ * numeric ranks, which overflow 64 bits for C(C(|V_G|,k), n) and (k!)^n).
+ *
+ * File layout (text, one field per line):
+ *   subgraphs-checkpoint 1
+ *   fingerprint <hash of P, G, n and the warm start>
+ *   combination <n> <subset rank>...
+ *   sequence <n> <permutation index>...
+ *   nodes <nodes explored so far>
+ *   lower_bound <proven lower bound>
+ *   cost <incumbent cost>
+ *   extension <edge count>
+ *   <source> <destination> <count>   (one line per incumbent edge)
+ */
+template <typename IndexType = int64_t> struct ExactCheckpoint {
+    uint64_t fingerprint{};             // Identifies the problem the checkpoint belongs to
+    std::vector<IndexType> combination; // Next combination set (ranks in the search order)
+    std::vector<IndexType> sequence;    // Next permutation sequence within that set
+    uint64_t nodesExplored{};
+    uint64_t lowerBound{};
+    uint64_t cost{};                    // Cost of the incumbent extension
+    std::vector<Edge<IndexType>> extension;
+
+    // Writes to "<path>.tmp", syncs it to disk and renames it over `path`, so a process
+    // crash or a power loss leaves either the previous or the new checkpoint behind, never a
+    // half-written one (on Windows the rename itself is not synced)
+    void save(const std::filesystem::path& path) const;
+
+    // Returns std::nullopt if the file does not exist; throws on malformed files, including
+    // incumbent edges between vertices outside 0..vertexCount-1 (|V_G| of the problem)
+    static std::optional<ExactCheckpoint> load(const std::filesystem::path& path,
+                                               uint64_t vertexCount);
+};
+
+} // namespace Subgraphs
+
+#include "exact_checkpoint.inl"
@@ -0,0 +1,210 @@
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#    include <fcntl.h>
+#    include <io.h>
+#else
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+namespace Subgraphs {
+
+inline constexpr const char* CHECKPOINT_MAGIC = "subgraphs-checkpoint";
+inline constexpr int CHECKPOINT_VERSION = 1;
+
+// "extension <edge count>" followed by one "<source> <destination> <count>" line per edge
+template <typename IndexType>
+void writeExtensionRecord(std::ostream& out, const std::vector<Edge<IndexType>>& extension) {
+    out << "extension " << extension.size() << '\n';
+    for (const auto& [source, destination, count] : extension) {
+        out << source << ' ' << destination << ' ' << static_cast<int>(count) << '\n';
+    }
+}
+
+// Reads the edges written by writeExtensionRecord (after the "extension" key). Returns
+// std::nullopt if an edge is malformed, names a vertex outside 0..vertexCount-1 (|V_G|), or
+// the counts do not add up to `cost`.
+template <typename IndexType>
+std::optional<std::vector<Edge<IndexType>>> readExtensionRecord(std::istream& in, uint64_t cost,
+                                                                uint64_t vertexCount) {
+    size_t edgeCount = 0;
+    if (!(in >> edgeCount)) {
+        return std::nullopt;
+    }
+    std::vector<Edge<IndexType>> extension;
+    uint64_t totalCount = 0;
+    for (size_t i = 0; i < edgeCount; ++i) {
+        int64_t source = 0;
+        int64_t destination = 0;
+        int count = 0;
+        if (!(in >> source >> destination >> count) || source < 0 || destination < 0 ||
+            static_cast<uint64_t>(source) >= vertexCount ||
+            static_cast<uint64_t>(destination) >= vertexCount || count <= 0 || count > 255) {
+            return std::nullopt;
+        }
+        extension.emplace_back(static_cast<IndexType>(source), static_cast<IndexType>(destination),
+                               static_cast<uint8_t>(count));
+        totalCount += static_cast<uint64_t>(count);
+    }
+    if (totalCount != cost) {
+        return std::nullopt;
+    }
+    return extension;
+}
+
+// Flushes a closed file's data to the storage device. Returns false if that fails.
+inline bool syncFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+    const int fd = _wopen(path.c_str(), _O_WRONLY | _O_BINARY);
+    if (fd < 0) {
+        return false;
+    }
+    const bool synced = _commit(fd) == 0;
+    _close(fd);
+#else
+    const int fd = ::open(path.c_str(), O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+    const bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+#endif
+    return synced;
+}
+
+// Makes a rename inside `directory` durable. Best effort: some file systems cannot sync a
+// directory, and Windows has no equivalent, so failures are ignored.
+inline void syncDirectory(const std::filesystem::path& directory) {
+#ifndef _WIN32
+    const int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)directory;
+#endif
+}
+
+// Moves a fully written `temporary` file over `path` so that a crash or power loss leaves
+// either the old or the new contents: the data is synced before the rename, the rename
+// after it. `what` names the file in the error message.
+inline void replaceDurably(const std::filesystem::path& temporary,
+                           const std::filesystem::path& path, const std::string& what) {
+    if (!syncFile(temporary)) {
+        throw std::runtime_error("Could not write " + what + ": " + temporary.string());
+    }
+    std::filesystem::rename(temporary, path);
+    syncDirectory(path.parent_path());
+}
+
+template <typename IndexType>
+void ExactCheckpoint<IndexType>::save(const std::filesystem::path& path) const {
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Could not write checkpoint: " + temporary.string());
+        }
+
+        auto writeVector = [&out](const char* key, const std::vector<IndexType>& values) {
+            out << key << ' ' << values.size();
+            for (IndexType value : values) {
+                out << ' ' << value;
+            }
+            out << '\n';
+        };
+
+        out << CHECKPOINT_MAGIC << ' ' << CHECKPOINT_VERSION << '\n';
+        out << "fingerprint " << fingerprint << '\n';
+        writeVector("combination", combination);
+        writeVector("sequence", sequence);
+        out << "nodes " << nodesExplored << '\n';
+        out << "lower_bound " << lowerBound << '\n';
+        out << "cost " << cost << '\n';
+        writeExtensionRecord(out, extension);
+        if (!out.flush()) {
+            throw std::runtime_error("Could not write checkpoint: " + temporary.string());
+        }
+    }
+    replaceDurably(temporary, path, "checkpoint");
+}
+
+template <typename IndexType>
+std::optional<ExactCheckpoint<IndexType>>
+ExactCheckpoint<IndexType>::load(const std::filesystem::path& path, uint64_t vertexCount) {
+    if (!std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open checkpoint: " + path.string());
+    }
+
+    auto fail = [&path](const std::string& field) {
+        throw std::runtime_error("Invalid checkpoint (" + field + "): " + path.string());
+    };
+    auto expectKey = [&](const char* key) {
+        std::string word;
+        if (!(in >> word) || word != key) {
+            fail(key);
+        }
+    };
+    auto readVector = [&](const char* key) {
+        expectKey(key);
+        size_t size = 0;
+        if (!(in >> size) || size > 1024) {
+            fail(key);
+        }
+        std::vector<IndexType> values(size);
+        for (IndexType& value : values) {
+            int64_t raw = 0;
+            if (!(in >> raw) || raw < 0) {
+                fail(key);
+            }
+            value = static_cast<IndexType>(raw);
+        }
+        return values;
+    };
+
+    ExactCheckpoint checkpoint;
+    int version = 0;
+    expectKey(CHECKPOINT_MAGIC);
+    if (!(in >> version) || version != CHECKPOINT_VERSION) {
+        fail("version");
+    }
+    expectKey("fingerprint");
+    if (!(in >> checkpoint.fingerprint)) {
+        fail("fingerprint");
+    }
+    checkpoint.combination = readVector("combination");
+    checkpoint.sequence = readVector("sequence");
+    expectKey("nodes");
+    if (!(in >> checkpoint.nodesExplored)) {
+        fail("nodes");
+    }
+    expectKey("lower_bound");
+    if (!(in >> checkpoint.lowerBound)) {
+        fail("lower_bound");
+    }
+    expectKey("cost");
+    if (!(in >> checkpoint.cost)) {
+        fail("cost");
+    }
+    expectKey("extension");
+    auto extension = readExtensionRecord<IndexType>(in, checkpoint.cost, vertexCount);
+    if (!extension) {
+        fail("extension");
+    }
+    checkpoint.extension = std::move(*extension);
+    return checkpoint;
+}
+
+} // namespace Subgraphs
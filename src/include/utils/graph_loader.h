@@ -2,11 +2,17 @@
 
 #include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <memory>
+#include <optional>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 #include "../graph/multigraph.h"
+#include "binary_format.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+#include "trace.h"
 
 namespace Subgraphs {
 
@@ -14,16 +20,87 @@ template <typename IndexType = int64_t> class GraphLoader {
   public:
     GraphLoader() = delete;
 
+    // Loads a graph pair from a text or binary file (detected from the file's magic bytes).
+    // In text files each graph is either an adjacency matrix or an "edges <n>" edge list.
+    // Dense graphs from a binary file are zero-copy views into the mapped file. Large text
+    // matrices are parsed on up to threadCount threads; callers already running on a pool
+    // pass 1.
     static std::pair<Multigraph<IndexType>, Multigraph<IndexType>>
-    loadFromFile(const std::filesystem::path& filePath);
+    loadFromFile(const std::filesystem::path& filePath,
+                 size_t threadCount = ThreadPool::defaultThreadCount());
+
+    // Writes the pair in the binary format; without an explicit encoding, each graph is
+    // stored sparse when that is smaller than its dense matrix
+    static void saveToBinaryFile(const Multigraph<IndexType>& g1, const Multigraph<IndexType>& g2,
+                                 const std::filesystem::path& filePath,
+                                 std::optional<BinaryEncoding> encoding = std::nullopt);
+
+    static bool isBinaryFile(const std::filesystem::path& filePath);
+
+    // Writes both graphs as "edges <n>" sections with one "u v [count]" line per edge
+    static void saveToEdgeListFile(const Multigraph<IndexType>& g1,
+                                   const Multigraph<IndexType>& g2,
+                                   const std::filesystem::path& filePath);
 
     static void saveToFile(const Multigraph<IndexType>& g1, const Multigraph<IndexType>& g2,
                            const std::vector<std::tuple<IndexType, IndexType, uint8_t>>& extension,
                            int subgraphsCount, const std::filesystem::path& filePath);
 
   private:
-    static std::vector<std::vector<uint8_t>>
-    loadAdjacencyMatrix(const std::filesystem::path& filePath);
+    // Matrices with at least this many entries are parsed in parallel
+    static constexpr size_t PARALLEL_PARSE_MIN_ENTRIES = size_t{1} << 20;
+    // Size of the blocks the text is cut into for parallel parsing
+    static constexpr size_t PARALLEL_PARSE_BLOCK_BYTES = size_t{1} << 20;
+
+    // Position of the parser inside a memory-mapped text file
+    struct TextCursor {
+        const char* position;
+        const char* end;
+        size_t line; // 1-based number of the line starting at `position`
+    };
+
+    static Multigraph<IndexType> loadAdjacencyMatrix(const std::filesystem::path& filePath);
+
+    // `pool` is used for large matrices; without one, every matrix is parsed serially
+    static Multigraph<IndexType> parseGraph(TextCursor& cursor, std::string_view matrixName,
+                                            const std::filesystem::path& filePath,
+                                            ThreadPool* pool);
+
+    static Multigraph<IndexType> parseMatrixRows(TextCursor& cursor, int n,
+                                                 std::string_view matrixName,
+                                                 const std::filesystem::path& filePath,
+                                                 ThreadPool* pool);
+
+    static void parseMatrixRowsParallel(TextCursor& cursor, size_t rowLength, uint8_t* matrix,
+                                        std::string_view matrixName,
+                                        const std::filesystem::path& filePath,
+                                        ThreadPool& pool);
+
+    static bool parseRow(const char* position, const char* lineEnd, size_t rowLength,
+                         uint8_t* row);
+
+    static Multigraph<IndexType> parseEdgeList(TextCursor& cursor, int n,
+                                               std::string_view matrixName,
+                                               const std::filesystem::path& filePath);
+
+    static const char* findLineEnd(const TextCursor& cursor);
+
+    static void nextLine(TextCursor& cursor, const char* lineEnd);
+
+    [[noreturn]] static void throwParseError(const TextCursor& cursor, const std::string& message,
+                                             const std::filesystem::path& filePath);
+
+    static bool parseInt(const char*& position, const char* lineEnd, int& value);
+
+    static bool hasBinaryMagic(const MappedFile& file);
+
+    static std::pair<Multigraph<IndexType>, Multigraph<IndexType>>
+    loadBinary(const std::shared_ptr<const MappedFile>& file,
+               const std::filesystem::path& filePath);
+
+    static Multigraph<IndexType> loadBinaryGraph(const std::shared_ptr<const MappedFile>& file,
+                                                 const BinaryGraphSection& section,
+                                                 const std::filesystem::path& filePath);
 };
 
 } // namespace Subgraphs
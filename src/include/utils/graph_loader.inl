@@ -1,108 +1,472 @@
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
 
 namespace Subgraphs {
 
+/**
+ * Reads one integer token from [position, lineEnd), skipping leading blanks like
+ * `std::istream >> int` does (a leading '+' is accepted too). On success `position`
+ * is moved past the token.
+ */
 template <typename IndexType>
-std::vector<std::vector<uint8_t>>
-GraphLoader<IndexType>::loadAdjacencyMatrix(const std::filesystem::path& filePath) {
-    std::ifstream infile(filePath);
-    if (!infile.is_open()) {
-        throw std::runtime_error("Could not open file: " + filePath.string());
+bool GraphLoader<IndexType>::parseInt(const char*& position, const char* lineEnd, int& value) {
+    while (position != lineEnd && (*position == ' ' || *position == '\t' || *position == '\r' ||
+                                   *position == '\v' || *position == '\f')) {
+        ++position;
+    }
+    // Fast path for the common case: a short run of decimal digits (edge multiplicities)
+    const char* digit = position;
+    int digits = 0;
+    int result = 0;
+    while (digit != lineEnd && digits < 9 && static_cast<unsigned char>(*digit - '0') < 10) {
+        result = result * 10 + (*digit - '0');
+        ++digit;
+        ++digits;
+    }
+    if (digits > 0 && (digit == lineEnd || static_cast<unsigned char>(*digit - '0') >= 10)) {
+        value = result;
+        position = digit;
+        return true;
+    }
+
+    const char* tokenBegin = position;
+    if (tokenBegin != lineEnd && *tokenBegin == '+' && tokenBegin + 1 != lineEnd &&
+        *(tokenBegin + 1) >= '0' && *(tokenBegin + 1) <= '9') {
+        ++tokenBegin;
     }
 
-    std::string line;
+    const auto [tokenEnd, error] = std::from_chars(tokenBegin, lineEnd, value);
+    if (error != std::errc{}) {
+        return false;
+    }
+    position = tokenEnd;
+    return true;
+}
+
+template <typename IndexType>
+const char* GraphLoader<IndexType>::findLineEnd(const TextCursor& cursor) {
+    const void* newline =
+        std::memchr(cursor.position, '\n', static_cast<size_t>(cursor.end - cursor.position));
+    return newline != nullptr ? static_cast<const char*>(newline) : cursor.end;
+}
+
+template <typename IndexType>
+void GraphLoader<IndexType>::nextLine(TextCursor& cursor, const char* lineEnd) {
+    cursor.position = lineEnd == cursor.end ? cursor.end : lineEnd + 1;
+    ++cursor.line;
+}
+
+template <typename IndexType>
+void GraphLoader<IndexType>::throwParseError(const TextCursor& cursor, const std::string& message,
+                                             const std::filesystem::path& filePath) {
+    throw std::runtime_error(message + " in file: " + filePath.string() + " (line " +
+                             std::to_string(cursor.line) + ")");
+}
+
+/**
+ * Parses one graph section starting at `cursor`. A section is either
+ * - a matrix: a size line followed by `size` rows, or
+ * - an edge list: an "edges <size>" line followed by "u v [count]" lines.
+ *
+ * Lines before the section header that start with neither an integer nor "edges" are
+ * skipped. Errors report the 1-based line number where parsing stopped.
+ */
+template <typename IndexType>
+Multigraph<IndexType> GraphLoader<IndexType>::parseGraph(TextCursor& cursor,
+                                                         std::string_view matrixName,
+                                                         const std::filesystem::path& filePath,
+                                                         ThreadPool* pool) {
+    constexpr std::string_view edgeListKeyword = "edges";
+
     int n = 0;
-    while (std::getline(infile, line)) {
-        std::istringstream iss(line);
-        if (iss >> n)
+    bool edgeList = false;
+    while (cursor.position != cursor.end) {
+        const char* lineEnd = findLineEnd(cursor);
+        const char* position = cursor.position;
+        while (position != lineEnd && (*position == ' ' || *position == '\t')) {
+            ++position;
+        }
+        const size_t lineLength = static_cast<size_t>(lineEnd - position);
+        if (lineLength > edgeListKeyword.size() &&
+            std::string_view(position, edgeListKeyword.size()) == edgeListKeyword &&
+            (position[edgeListKeyword.size()] == ' ' || position[edgeListKeyword.size()] == '\t')) {
+            position += edgeListKeyword.size();
+            edgeList = true;
+            if (!parseInt(position, lineEnd, n)) {
+                n = 0;
+            }
+            if (n > 0) {
+                nextLine(cursor, lineEnd);
+            }
             break;
+        }
+        if (parseInt(position, lineEnd, n)) {
+            if (n > 0) {
+                nextLine(cursor, lineEnd);
+            }
+            break;
+        }
+        nextLine(cursor, lineEnd);
+    }
+    if (n <= 0) {
+        throwParseError(cursor, "Invalid or missing " + std::string(matrixName) + " size",
+                        filePath);
+    }
+    // Matrix rows and edge lists both store the size as IndexType, which must not truncate
+    // it. The size line has already been consumed, so the error points one line back.
+    if (static_cast<uint64_t>(n) > static_cast<uint64_t>(std::numeric_limits<IndexType>::max())) {
+        const TextCursor sizeCursor{cursor.position, cursor.end, cursor.line - 1};
+        throwParseError(sizeCursor,
+                        "Vertex count " + std::to_string(n) + " of " + std::string(matrixName) +
+                            " exceeds the index type",
+                        filePath);
     }
-    if (n <= 0)
-        throw std::runtime_error("Invalid or missing matrix size in file: " + filePath.string());
 
-    std::vector<std::vector<uint8_t>> matrix;
-    for (int i = 0; i < n; ++i) {
-        if (!std::getline(infile, line))
-            throw std::runtime_error("Unexpected end of file while reading adjacency matrix: " +
-                                     filePath.string());
-        std::istringstream iss(line);
-        std::vector<uint8_t> row;
-        int val;
-        for (int j = 0; j < n; ++j) {
-            if (!(iss >> val))
-                throw std::runtime_error("Malformed adjacency matrix row in file: " +
-                                         filePath.string());
-            row.push_back(static_cast<uint8_t>(val));
+    return edgeList ? parseEdgeList(cursor, n, matrixName, filePath)
+                    : parseMatrixRows(cursor, n, matrixName, filePath, pool);
+}
+
+/**
+ * Parses at least `rowLength` integers from [position, lineEnd) into `row` (or only
+ * validates them when `row` is null). Returns false for a malformed row.
+ */
+template <typename IndexType>
+bool GraphLoader<IndexType>::parseRow(const char* position, const char* lineEnd,
+                                      size_t rowLength, uint8_t* row) {
+    int val;
+    for (size_t j = 0; j < rowLength; ++j) {
+        if (!parseInt(position, lineEnd, val)) {
+            return false;
+        }
+        if (row != nullptr) {
+            row[j] = static_cast<uint8_t>(val);
         }
-        matrix.push_back(std::move(row));
     }
-    return matrix;
+    return true;
+}
+
+/**
+ * Parses `n` matrix rows directly into a flat row-major buffer that becomes the
+ * Multigraph's storage. Each row must be on its own line and hold at least `n`
+ * integers; anything after them on the line is ignored.
+ *
+ * Large matrices are handed to parseMatrixRowsParallel when the caller provides a pool.
+ */
+template <typename IndexType>
+Multigraph<IndexType>
+GraphLoader<IndexType>::parseMatrixRows(TextCursor& cursor, int n, std::string_view matrixName,
+                                        const std::filesystem::path& filePath, ThreadPool* pool) {
+    // Every value takes at least one byte, so a size that cannot fit into the rest of the
+    // file is bound to fail. Such rows are still parsed (to report the right error and
+    // line) but not stored, so a bogus size never triggers a huge allocation.
+    const size_t rowLength = static_cast<size_t>(n);
+    const size_t remaining = static_cast<size_t>(cursor.end - cursor.position);
+    const bool fitsInFile = rowLength * rowLength <= remaining;
+    std::vector<uint8_t> matrix(fitsInFile ? rowLength * rowLength : 0);
+
+    if (fitsInFile && rowLength * rowLength >= PARALLEL_PARSE_MIN_ENTRIES && pool != nullptr) {
+        parseMatrixRowsParallel(cursor, rowLength, matrix.data(), matrixName, filePath, *pool);
+        return Multigraph<IndexType>(static_cast<IndexType>(n), std::move(matrix));
+    }
+
+    for (size_t i = 0; i < rowLength; ++i) {
+        if (cursor.position == cursor.end) {
+            throwParseError(cursor,
+                            "Unexpected end of file while reading " + std::string(matrixName),
+                            filePath);
+        }
+        const char* lineEnd = findLineEnd(cursor);
+        uint8_t* row = fitsInFile ? matrix.data() + i * rowLength : nullptr;
+        if (!parseRow(cursor.position, lineEnd, rowLength, row)) {
+            throwParseError(cursor, "Malformed " + std::string(matrixName) + " row", filePath);
+        }
+        nextLine(cursor, lineEnd);
+    }
+
+    return Multigraph<IndexType>(static_cast<IndexType>(n), std::move(matrix));
+}
+
+/**
+ * Parallel version of the row loop in parseMatrixRows, for multi-megabyte matrices.
+ *
+ * The rest of the file is cut into fixed-size blocks. A first parallel pass counts the
+ * newlines in the blocks, a wave of blocks at a time; their prefix sums give the index of the
+ * first row that starts inside each block. Counting stops after the wave in which row
+ * `rowLength` is reached, so text after the matrix (e.g. the second graph) is not scanned.
+ * A second parallel pass then parses, for every block, the rows that start inside it,
+ * straight into their final place in `matrix`.
+ *
+ * Every row knows its index, so errors are reported with the same message and exact
+ * line number as the serial loop (the lowest failing row wins).
+ */
+template <typename IndexType>
+void GraphLoader<IndexType>::parseMatrixRowsParallel(TextCursor& cursor, size_t rowLength,
+                                                     uint8_t* matrix,
+                                                     std::string_view matrixName,
+                                                     const std::filesystem::path& filePath,
+                                                     ThreadPool& pool) {
+    const char* begin = cursor.position;
+    const char* end = cursor.end;
+    const size_t blockCount =
+        (static_cast<size_t>(end - begin) + PARALLEL_PARSE_BLOCK_BYTES - 1) /
+        PARALLEL_PARSE_BLOCK_BYTES;
+    auto blockBegin = [&](size_t block) { return begin + block * PARALLEL_PARSE_BLOCK_BYTES; };
+    auto blockEnd = [&](size_t block) {
+        return block + 1 == blockCount ? end : blockBegin(block + 1);
+    };
+
+    const size_t chunkCount = pool.size() * 4;
+
+    // ===== Pass 1: newlines per block, one wave of a block per thread at a time =====
+    // firstRow[b] = number of newlines before block b = index of the row starting right after
+    // the first newline at or after blockBegin(b) - 1
+    std::vector<size_t> firstRow(blockCount + 1, 0);
+    size_t countedBlocks = 0;
+    while (countedBlocks < blockCount && firstRow[countedBlocks] < rowLength) {
+        const size_t waveBegin = countedBlocks;
+        const size_t waveEnd = std::min(blockCount, waveBegin + pool.size());
+        pool.parallelFor(waveEnd - waveBegin, pool.size(), [&](size_t first, size_t last) {
+            TraceSpan span("count rows", "loader", "first block",
+                           static_cast<int64_t>(waveBegin + first));
+            for (size_t block = waveBegin + first; block < waveBegin + last; ++block) {
+                firstRow[block + 1] =
+                    static_cast<size_t>(std::count(blockBegin(block), blockEnd(block), '\n'));
+            }
+        });
+        for (size_t block = waveBegin; block < waveEnd; ++block) {
+            firstRow[block + 1] += firstRow[block];
+        }
+        countedBlocks = waveEnd;
+    }
+
+    // Rows that start before the end of the counted text (a trailing newline does not start
+    // one). Counting stops early only once rowLength rows are known to exist.
+    const size_t availableRows =
+        firstRow[countedBlocks] + (countedBlocks == blockCount && *(end - 1) != '\n' ? 1 : 0);
+
+    // Blocks in which no row below rowLength can start are not needed
+    size_t neededBlocks = 0;
+    while (neededBlocks < countedBlocks && firstRow[neededBlocks] < rowLength) {
+        ++neededBlocks;
+    }
+
+    // ===== Pass 2: parse the rows starting in each block =====
+    constexpr size_t noError = std::numeric_limits<size_t>::max();
+    std::vector<size_t> malformedRow(neededBlocks, noError);
+    const char* matrixEnd = end; // Start of the line after the last row
+    pool.parallelFor(neededBlocks, chunkCount, [&](size_t first, size_t last) {
+        TraceSpan span("parse rows", "loader", "first block", static_cast<int64_t>(first));
+        for (size_t block = first; block < last; ++block) {
+            const char* rowStart = blockBegin(block);
+            size_t row = 0;
+            if (block > 0) {
+                const char* newline = static_cast<const char*>(std::memchr(
+                    rowStart - 1, '\n', static_cast<size_t>(blockEnd(block) - rowStart + 1)));
+                if (newline == nullptr) {
+                    continue; // The whole block is inside one row
+                }
+                row = firstRow[block] + (newline >= rowStart ? 1 : 0);
+                rowStart = newline + 1;
+            }
+
+            while (rowStart < blockEnd(block) && row < rowLength) {
+                const void* newline =
+                    std::memchr(rowStart, '\n', static_cast<size_t>(end - rowStart));
+                const char* lineEnd = newline != nullptr ? static_cast<const char*>(newline) : end;
+                if (!parseRow(rowStart, lineEnd, rowLength, matrix + row * rowLength)) {
+                    malformedRow[block] = row;
+                    break;
+                }
+                rowStart = lineEnd == end ? end : lineEnd + 1;
+                if (row + 1 == rowLength) {
+                    matrixEnd = rowStart; // Written by exactly one block
+                }
+                ++row;
+            }
+        }
+    });
+
+    size_t errorRow = noError;
+    for (size_t row : malformedRow) {
+        errorRow = std::min(errorRow, row);
+    }
+    if (availableRows < rowLength && availableRows <= errorRow) {
+        TextCursor errorCursor{end, end, cursor.line + availableRows};
+        throwParseError(errorCursor,
+                        "Unexpected end of file while reading " + std::string(matrixName),
+                        filePath);
+    }
+    if (errorRow != noError) {
+        TextCursor errorCursor{begin, end, cursor.line + errorRow};
+        throwParseError(errorCursor, "Malformed " + std::string(matrixName) + " row", filePath);
+    }
+
+    cursor.position = matrixEnd;
+    cursor.line += rowLength;
+}
+
+/**
+ * Streams "u v [count]" lines (count defaults to 1) into an n×n matrix, so the text
+ * scales with the number of edges instead of n². Repeated pairs add up. Blank lines and
+ * lines starting with '#' are skipped; the list ends at the next section header (a line
+ * holding a single integer or starting with "edges") or at the end of the file.
+ */
+template <typename IndexType>
+Multigraph<IndexType>
+GraphLoader<IndexType>::parseEdgeList(TextCursor& cursor, int n, std::string_view matrixName,
+                                      const std::filesystem::path& filePath) {
+    const size_t vertexCount = static_cast<size_t>(n);
+    std::vector<uint8_t> matrix(vertexCount * vertexCount, 0);
+
+    while (cursor.position != cursor.end) {
+        const char* lineEnd = findLineEnd(cursor);
+        const char* position = cursor.position;
+        while (position != lineEnd && (*position == ' ' || *position == '\t' ||
+                                       *position == '\r')) {
+            ++position;
+        }
+        if (position == lineEnd || *position == '#') {
+            nextLine(cursor, lineEnd);
+            continue;
+        }
+
+        int source;
+        int destination;
+        if (*position == 'e' || !parseInt(position, lineEnd, source)) {
+            break; // Not an edge: the next section starts here
+        }
+        const char* afterSource = position;
+        if (!parseInt(position, lineEnd, destination)) {
+            while (afterSource != lineEnd && (*afterSource == ' ' || *afterSource == '\t' ||
+                                              *afterSource == '\r')) {
+                ++afterSource;
+            }
+            if (afterSource == lineEnd) {
+                break; // A lone integer: size line of the next matrix section
+            }
+            throwParseError(cursor, "Malformed " + std::string(matrixName) + " edge", filePath);
+        }
+        int count = 1;
+        if (!parseInt(position, lineEnd, count)) {
+            // The count is optional, but anything else after the destination is an error
+            while (position != lineEnd && (*position == ' ' || *position == '\t' ||
+                                           *position == '\r')) {
+                ++position;
+            }
+            if (position != lineEnd) {
+                throwParseError(cursor, "Malformed " + std::string(matrixName) + " edge",
+                                filePath);
+            }
+            count = 1;
+        }
+
+        if (source < 0 || source >= n || destination < 0 || destination >= n) {
+            throwParseError(cursor,
+                            "Edge vertex out of range in " + std::string(matrixName), filePath);
+        }
+        uint8_t& cell = matrix[static_cast<size_t>(source) * vertexCount +
+                               static_cast<size_t>(destination)];
+        if (count < 0 || cell + count > std::numeric_limits<uint8_t>::max()) {
+            throwParseError(cursor, "Invalid edge multiplicity in " + std::string(matrixName),
+                            filePath);
+        }
+        cell = static_cast<uint8_t>(cell + count);
+        nextLine(cursor, lineEnd);
+    }
+
+    return Multigraph<IndexType>(static_cast<IndexType>(n), std::move(matrix));
+}
+
+template <typename IndexType>
+Multigraph<IndexType>
+GraphLoader<IndexType>::loadAdjacencyMatrix(const std::filesystem::path& filePath) {
+    const MappedFile file(filePath);
+    TextCursor cursor{file.data(), file.data() + file.size(), 1};
+    return parseGraph(cursor, "adjacency matrix", filePath, nullptr);
 }
 
 template <typename IndexType>
 std::pair<Multigraph<IndexType>, Multigraph<IndexType>>
-GraphLoader<IndexType>::loadFromFile(const std::filesystem::path& filePath) {
-    std::ifstream infile(filePath);
-    if (!infile.is_open()) {
-        throw std::runtime_error("Could not open file: " + filePath.string());
+GraphLoader<IndexType>::loadFromFile(const std::filesystem::path& filePath,
+                                     size_t threadCount) {
+    TraceSpan span("GraphLoader::loadFromFile", "loader");
+    auto file = std::make_shared<const MappedFile>(filePath);
+    if (hasBinaryMagic(*file)) {
+        return loadBinary(file, filePath);
     }
 
-    std::string line;
-    int n1 = 0;
-    while (std::getline(infile, line)) {
-        std::istringstream iss(line);
-        if (iss >> n1)
-            break;
+    TextCursor cursor{file->data(), file->data() + file->size(), 1};
+
+    // One pool serves both graphs. A matrix with PARALLEL_PARSE_MIN_ENTRIES entries takes at
+    // least that many bytes of text, so smaller files never need one.
+    std::optional<ThreadPool> pool;
+    if (threadCount > 1 && file->size() >= PARALLEL_PARSE_MIN_ENTRIES) {
+        pool.emplace(threadCount);
     }
-    if (n1 <= 0)
-        throw std::runtime_error("Invalid or missing first matrix size in file: " +
-                                 filePath.string());
+    ThreadPool* parsePool = pool ? &*pool : nullptr;
 
-    std::vector<std::vector<uint8_t>> matrix1;
-    for (int i = 0; i < n1; ++i) {
-        if (!std::getline(infile, line))
-            throw std::runtime_error("Unexpected end of file while reading first matrix: " +
-                                     filePath.string());
-        std::istringstream iss(line);
-        std::vector<uint8_t> row;
-        int val;
-        for (int j = 0; j < n1; ++j) {
-            if (!(iss >> val))
-                throw std::runtime_error("Malformed first matrix row in file: " +
-                                         filePath.string());
-            row.push_back(static_cast<uint8_t>(val));
-        }
-        matrix1.push_back(std::move(row));
-    }
-
-    int n2 = 0;
-    while (std::getline(infile, line)) {
-        std::istringstream iss(line);
-        if (iss >> n2)
-            break;
+    Multigraph<IndexType> g1 = parseGraph(cursor, "first matrix", filePath, parsePool);
+    Multigraph<IndexType> g2 = parseGraph(cursor, "second matrix", filePath, parsePool);
+
+    if (g1 < g2) {
+        return {std::move(g1), std::move(g2)};
     }
-    if (n2 <= 0)
-        throw std::runtime_error("Invalid or missing second matrix size in file: " +
+
+    return {std::move(g2), std::move(g1)};
+}
+
+template <typename IndexType>
+bool GraphLoader<IndexType>::hasBinaryMagic(const MappedFile& file) {
+    return file.size() >= sizeof(BINARY_MAGIC) &&
+           std::memcmp(file.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
+
+template <typename IndexType>
+bool GraphLoader<IndexType>::isBinaryFile(const std::filesystem::path& filePath) {
+    return hasBinaryMagic(MappedFile(filePath));
+}
+
+template <typename IndexType>
+std::pair<Multigraph<IndexType>, Multigraph<IndexType>>
+GraphLoader<IndexType>::loadBinary(const std::shared_ptr<const MappedFile>& file,
+                                   const std::filesystem::path& filePath) {
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error("Binary graph files are only supported on little-endian hosts: " +
                                  filePath.string());
+    }
 
-    std::vector<std::vector<uint8_t>> matrix2;
-    for (int i = 0; i < n2; ++i) {
-        if (!std::getline(infile, line))
-            throw std::runtime_error("Unexpected end of file while reading second matrix: " +
+    BinaryGraphHeader header;
+    if (file->size() < sizeof(header)) {
+        throw std::runtime_error("Truncated binary graph header in file: " + filePath.string());
+    }
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.version != BINARY_FORMAT_VERSION || header.headerSize != sizeof(header)) {
+        throw std::runtime_error("Unsupported binary graph format version " +
+                                 std::to_string(header.version) + " in file: " + filePath.string());
+    }
+
+    // Validate both sections before touching (and hashing) their payloads
+    const auto* bytes = reinterpret_cast<const uint8_t*>(file->data());
+    uint64_t checksum = binaryChecksum(nullptr, 0);
+    for (const BinaryGraphSection& section : header.graphs) {
+        if (section.payloadOffset % BINARY_PAYLOAD_ALIGNMENT != 0 ||
+            section.payloadOffset > file->size() ||
+            section.payloadSize > file->size() - section.payloadOffset) {
+            throw std::runtime_error("Corrupt binary graph payload bounds in file: " +
                                      filePath.string());
-        std::istringstream iss(line);
-        std::vector<uint8_t> row;
-        int val;
-        for (int j = 0; j < n2; ++j) {
-            if (!(iss >> val))
-                throw std::runtime_error("Malformed second matrix row in file: " +
-                                         filePath.string());
-            row.push_back(static_cast<uint8_t>(val));
         }
-        matrix2.push_back(std::move(row));
+        checksum = binaryChecksum(bytes + section.payloadOffset,
+                                  static_cast<size_t>(section.payloadSize), checksum);
+    }
+    if (binaryFileChecksum(header, checksum) != header.checksum) {
+        throw std::runtime_error("Checksum mismatch in binary graph file: " + filePath.string());
     }
 
-    Multigraph<IndexType> g1(std::move(matrix1));
-    Multigraph<IndexType> g2(std::move(matrix2));
+    Multigraph<IndexType> g1 = loadBinaryGraph(file, header.graphs[0], filePath);
+    Multigraph<IndexType> g2 = loadBinaryGraph(file, header.graphs[1], filePath);
 
     if (g1 < g2) {
         return {std::move(g1), std::move(g2)};
@@ -111,6 +475,165 @@ GraphLoader<IndexType>::loadFromFile(const std::filesystem::path& filePath) {
     return {std::move(g2), std::move(g1)};
 }
 
+/**
+ * Builds one graph from a validated section. Dense payloads are wrapped without copying
+ * (the Multigraph keeps the mapped file alive); sparse payloads are expanded into an owned
+ * dense matrix.
+ */
+template <typename IndexType>
+Multigraph<IndexType>
+GraphLoader<IndexType>::loadBinaryGraph(const std::shared_ptr<const MappedFile>& file,
+                                        const BinaryGraphSection& section,
+                                        const std::filesystem::path& filePath) {
+    // Sparse records store 32-bit vertex ids, which also keeps vertexCount² from overflowing
+    if (section.vertexCount == 0 ||
+        section.vertexCount > static_cast<uint64_t>(std::numeric_limits<IndexType>::max()) ||
+        section.vertexCount > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Invalid vertex count " + std::to_string(section.vertexCount) +
+                                 " in binary graph file: " + filePath.string());
+    }
+    const auto n = static_cast<size_t>(section.vertexCount);
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(file->data()) + section.payloadOffset;
+
+    if (section.encoding == static_cast<uint32_t>(BinaryEncoding::DENSE)) {
+        if (section.payloadSize != static_cast<uint64_t>(n) * n) {
+            throw std::runtime_error("Dense payload size does not match vertex count in file: " +
+                                     filePath.string());
+        }
+        return Multigraph<IndexType>(static_cast<IndexType>(n),
+                                     static_cast<IndexType>(section.edgeCount), payload, file);
+    }
+
+    if (section.encoding == static_cast<uint32_t>(BinaryEncoding::SPARSE)) {
+        if (section.payloadSize % sizeof(BinarySparseEdge) != 0) {
+            throw std::runtime_error("Sparse payload size is not a whole number of edges in "
+                                     "file: " + filePath.string());
+        }
+        std::vector<uint8_t> matrix(n * n, 0);
+        const size_t edgeRecords =
+            static_cast<size_t>(section.payloadSize) / sizeof(BinarySparseEdge);
+        for (size_t i = 0; i < edgeRecords; ++i) {
+            BinarySparseEdge edge;
+            std::memcpy(&edge, payload + i * sizeof(BinarySparseEdge), sizeof(edge));
+            if (edge.source >= n || edge.destination >= n) {
+                throw std::runtime_error("Sparse edge out of range in file: " + filePath.string());
+            }
+            matrix[static_cast<size_t>(edge.source) * n + edge.destination] = edge.count;
+        }
+        return Multigraph<IndexType>(static_cast<IndexType>(n), std::move(matrix));
+    }
+
+    throw std::runtime_error("Unknown graph encoding " + std::to_string(section.encoding) +
+                             " in binary graph file: " + filePath.string());
+}
+
+template <typename IndexType>
+void GraphLoader<IndexType>::saveToBinaryFile(const Multigraph<IndexType>& g1,
+                                              const Multigraph<IndexType>& g2,
+                                              const std::filesystem::path& filePath,
+                                              std::optional<BinaryEncoding> encoding) {
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error("Binary graph files are only supported on little-endian hosts: " +
+                                 filePath.string());
+    }
+
+    // Encode both payloads up front: the header needs their sizes and checksum
+    BinaryGraphHeader header{};
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_FORMAT_VERSION;
+    header.headerSize = sizeof(BinaryGraphHeader);
+
+    const Multigraph<IndexType>* graphs[2] = {&g1, &g2};
+    std::vector<BinarySparseEdge> sparsePayloads[2];
+    size_t offset = alignPayloadOffset(sizeof(BinaryGraphHeader));
+    uint64_t checksum = binaryChecksum(nullptr, 0);
+    for (size_t g = 0; g < 2; ++g) {
+        const Multigraph<IndexType>& graph = *graphs[g];
+        const auto n = static_cast<size_t>(graph.getVertexCount());
+        const uint8_t* matrix = graph.data();
+
+        std::vector<BinarySparseEdge>& sparse = sparsePayloads[g];
+        const size_t denseSize = n * n;
+        const bool useSparse = encoding ? *encoding == BinaryEncoding::SPARSE : [&] {
+            size_t nonZero = 0;
+            for (size_t i = 0; i < denseSize; ++i) {
+                nonZero += matrix[i] != 0 ? 1 : 0;
+            }
+            return nonZero * sizeof(BinarySparseEdge) < denseSize;
+        }();
+        if (useSparse) {
+            for (size_t i = 0; i < denseSize; ++i) {
+                if (matrix[i] != 0) {
+                    sparse.push_back({static_cast<uint32_t>(i / n), static_cast<uint32_t>(i % n),
+                                      matrix[i], {}});
+                }
+            }
+        }
+
+        BinaryGraphSection& section = header.graphs[g];
+        section.vertexCount = n;
+        section.edgeCount = static_cast<uint64_t>(graph.getEdgeCount());
+        section.encoding = static_cast<uint32_t>(useSparse ? BinaryEncoding::SPARSE
+                                                           : BinaryEncoding::DENSE);
+        section.payloadOffset = offset;
+        section.payloadSize = useSparse ? sparse.size() * sizeof(BinarySparseEdge) : denseSize;
+        const auto* payload =
+            useSparse ? reinterpret_cast<const uint8_t*>(sparse.data()) : matrix;
+        checksum = binaryChecksum(payload, static_cast<size_t>(section.payloadSize), checksum);
+        offset = alignPayloadOffset(offset + static_cast<size_t>(section.payloadSize));
+    }
+    header.checksum = binaryFileChecksum(header, checksum);
+
+    std::ofstream outfile(filePath, std::ios::binary);
+    if (!outfile.is_open()) {
+        throw std::runtime_error("Could not open file: " + filePath.string());
+    }
+
+    const char padding[BINARY_PAYLOAD_ALIGNMENT] = {};
+    size_t written = sizeof(header);
+    outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (size_t g = 0; g < 2; ++g) {
+        const BinaryGraphSection& section = header.graphs[g];
+        outfile.write(padding, static_cast<std::streamsize>(section.payloadOffset - written));
+        const char* payload = section.encoding == static_cast<uint32_t>(BinaryEncoding::SPARSE)
+                                  ? reinterpret_cast<const char*>(sparsePayloads[g].data())
+                                  : reinterpret_cast<const char*>(graphs[g]->data());
+        outfile.write(payload, static_cast<std::streamsize>(section.payloadSize));
+        written = static_cast<size_t>(section.payloadOffset + section.payloadSize);
+    }
+    if (!outfile) {
+        throw std::runtime_error("Could not write file: " + filePath.string());
+    }
+}
+
+template <typename IndexType>
+void GraphLoader<IndexType>::saveToEdgeListFile(const Multigraph<IndexType>& g1,
+                                                const Multigraph<IndexType>& g2,
+                                                const std::filesystem::path& filePath) {
+    std::ofstream outfile(filePath);
+    if (!outfile.is_open()) {
+        throw std::runtime_error("Could not open file: " + filePath.string());
+    }
+
+    for (const Multigraph<IndexType>* graph : {&g1, &g2}) {
+        const IndexType n = graph->getVertexCount();
+        outfile << "edges " << n << "\n";
+        for (IndexType i = 0; i < n; ++i) {
+            for (IndexType j = 0; j < n; ++j) {
+                const uint8_t count = graph->getEdges(i, j);
+                if (count == 0) {
+                    continue;
+                }
+                outfile << i << " " << j;
+                if (count != 1) {
+                    outfile << " " << static_cast<int>(count);
+                }
+                outfile << "\n";
+            }
+        }
+    }
+}
+
 template <typename IndexType>
 void GraphLoader<IndexType>::saveToFile(
     const Multigraph<IndexType>& g1, const Multigraph<IndexType>& g2,
@@ -2,6 +2,9 @@
 
 #include <filesystem>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "../algorithms/subgraph_algorithm.h"
@@ -9,6 +12,28 @@
 
 namespace Subgraphs {
 
+// How the CLI reports a result: human-readable text with matrix dumps, or one
+// machine-readable JSON object / CSV table without them
+enum class OutputFormat {
+    TEXT,
+    JSON,
+    CSV,
+};
+
+inline std::optional<OutputFormat> parseOutputFormat(std::string_view name);
+
+// Everything the machine-readable formats report about a single run
+template <typename IndexType = int64_t> struct RunReport {
+    std::string file;
+    int subgraphs{1};
+    AlgorithmType algorithm{AlgorithmType::EXACT};
+    std::optional<HeuristicType> heuristic; // Only set for approx2
+    std::vector<Edge<IndexType>> extension;
+    std::optional<ExactSearchStats> exactStats; // Only set for the exact algorithm
+    PhaseTimings timings;
+    double totalMs{};                       // Wall-clock time from loading to the result
+};
+
 template <typename IndexType = int64_t> class GraphPrinter {
   public:
     static void printAdjacencyMatrix(const std::vector<std::vector<uint8_t>>& adjMatrix);
@@ -18,6 +43,15 @@ template <typename IndexType = int64_t> class GraphPrinter {
     static void printResults(const Multigraph<IndexType>& patternGraph,
                              const Multigraph<IndexType>& targetGraph,
                              const std::vector<Edge<IndexType>>& extension);
+
+    // One JSON object on a single line: run parameters, "cost", "extension" as
+    // [source, destination, count] triples and "timings_ms" with the phase breakdown.
+    // Exact runs add "optimal", "lower_bound", "gap", "nodes" and "initial_cost".
+    static void printJson(std::ostream& out, const RunReport<IndexType>& report);
+
+    // A "record,source,destination,value" table: one "edge" row per extension edge,
+    // followed by "cost", the exact search rows (if any) and one "<phase>_ms" row per timing
+    static void printCsv(std::ostream& out, const RunReport<IndexType>& report);
 };
 
 } // namespace Subgraphs
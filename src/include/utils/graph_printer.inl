@@ -1,6 +1,21 @@
 
+#include "json_output.h"
+
 namespace Subgraphs {
 
+inline std::optional<OutputFormat> parseOutputFormat(std::string_view name) {
+    if (name == "text") {
+        return OutputFormat::TEXT;
+    }
+    if (name == "json") {
+        return OutputFormat::JSON;
+    }
+    if (name == "csv") {
+        return OutputFormat::CSV;
+    }
+    return std::nullopt;
+}
+
 template <typename IndexType>
 void GraphPrinter<IndexType>::printAdjacencyMatrix(
     const std::vector<std::vector<uint8_t>>& adjMatrix) {
@@ -63,4 +78,70 @@ void GraphPrinter<IndexType>::printResults(const Multigraph<IndexType>& patternG
     printGraph(modifiedGraph, "Modified Target Graph (after adding extension)");
 }
 
+template <typename IndexType>
+void GraphPrinter<IndexType>::printJson(std::ostream& out, const RunReport<IndexType>& report) {
+    std::string line = "{\"file\":";
+    appendJsonString(line, report.file);
+    line += ",\"n\":" + std::to_string(report.subgraphs);
+    line += ",\"algorithm\":\"" + std::string(algorithmName(report.algorithm)) + "\"";
+    if (report.heuristic) {
+        line += ",\"heuristic\":\"" + std::string(heuristicName(*report.heuristic)) + "\"";
+    }
+    line += ",\"cost\":" +
+            std::to_string(SubgraphAlgorithm<IndexType>::extensionCost(report.extension));
+    if (report.exactStats) {
+        line += ",\"optimal\":";
+        line += report.exactStats->optimal ? "true" : "false";
+        line += ",\"lower_bound\":" + std::to_string(report.exactStats->lowerBound);
+        line += ",\"gap\":" + std::to_string(report.exactStats->gap());
+        line += ",\"nodes\":" + std::to_string(report.exactStats->nodesExplored);
+        line += ",\"initial_cost\":" + std::to_string(report.exactStats->initialCost);
+    }
+    line += ",\"extension\":";
+    appendJsonExtension(line, report.extension);
+
+    const PhaseTimings& timings = report.timings;
+    line += ",\"timings_ms\":{\"load\":" + std::to_string(timings.loadMs);
+    line += ",\"phase1\":" + std::to_string(timings.phase1Ms);
+    line += ",\"phase2\":" + std::to_string(timings.phase2Ms);
+    line += ",\"assignment\":" + std::to_string(timings.assignmentMs);
+    line += ",\"merge\":" + std::to_string(timings.mergeMs);
+    line += ",\"total\":" + std::to_string(report.totalMs);
+    line += "}}\n";
+    out << line;
+}
+
+template <typename IndexType>
+void GraphPrinter<IndexType>::printCsv(std::ostream& out, const RunReport<IndexType>& report) {
+    std::string table = "record,source,destination,value\n";
+    for (const auto& [source, destination, count] : report.extension) {
+        table += "edge," + std::to_string(source) + "," + std::to_string(destination) + "," +
+                 std::to_string(static_cast<int>(count)) + "\n";
+    }
+
+    auto appendValue = [&table](std::string_view record, const std::string& value) {
+        table += record;
+        table += ",,,";
+        table += value;
+        table += '\n';
+    };
+    const PhaseTimings& timings = report.timings;
+    appendValue("cost",
+                std::to_string(SubgraphAlgorithm<IndexType>::extensionCost(report.extension)));
+    if (report.exactStats) {
+        appendValue("optimal", report.exactStats->optimal ? "true" : "false");
+        appendValue("lower_bound", std::to_string(report.exactStats->lowerBound));
+        appendValue("gap", std::to_string(report.exactStats->gap()));
+        appendValue("nodes", std::to_string(report.exactStats->nodesExplored));
+        appendValue("initial_cost", std::to_string(report.exactStats->initialCost));
+    }
+    appendValue("load_ms", std::to_string(timings.loadMs));
+    appendValue("phase1_ms", std::to_string(timings.phase1Ms));
+    appendValue("phase2_ms", std::to_string(timings.phase2Ms));
+    appendValue("assignment_ms", std::to_string(timings.assignmentMs));
+    appendValue("merge_ms", std::to_string(timings.mergeMs));
+    appendValue("total_ms", std::to_string(report.totalMs));
+    out << table;
+}
+
 } // namespace Subgraphs
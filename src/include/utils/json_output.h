@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../graph/edge.h"
+
+namespace Subgraphs {
+
+// Appends `text` to `out` as a quoted JSON string, escaping quotes, backslashes and
+// control characters
+inline void appendJsonString(std::string& out, std::string_view text) {
+    static constexpr char hexDigits[] = "0123456789abcdef";
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out += hexDigits[(static_cast<unsigned char>(c) >> 4) & 0xF];
+                    out += hexDigits[static_cast<unsigned char>(c) & 0xF];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+// Appends an extension as a JSON array of [source, destination, count] triples
+template <typename IndexType>
+void appendJsonExtension(std::string& out, const std::vector<Edge<IndexType>>& extension) {
+    out += '[';
+    for (size_t i = 0; i < extension.size(); ++i) {
+        out += i > 0 ? ",[" : "[";
+        out += std::to_string(extension[i].source) + "," +
+               std::to_string(extension[i].destination) + "," +
+               std::to_string(static_cast<int>(extension[i].count)) + "]";
+    }
+    out += ']';
+}
+
+} // namespace Subgraphs
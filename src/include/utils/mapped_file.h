@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace Subgraphs {
+
+// Read-only memory mapping of a whole file. The contents stay valid for the lifetime of
+// the object; an empty file maps to an empty view.
+class MappedFile {
+  public:
+    // SEQUENTIAL lets the kernel read ahead aggressively and drop pages behind the reader
+    // (parsers); DEFAULT keeps the usual page cache behavior for files read repeatedly
+    enum class Access { SEQUENTIAL, DEFAULT };
+
+    explicit MappedFile(const std::filesystem::path& filePath,
+                        Access access = Access::SEQUENTIAL);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    const char* data() const;
+    size_t size() const;
+    std::string_view contents() const;
+
+  private:
+    void unmap() noexcept;
+
+    const char* mappedData{nullptr};
+    size_t mappedSize{0};
+#ifdef _WIN32
+    void* fileHandle{nullptr};
+    void* mappingHandle{nullptr};
+#endif
+};
+
+} // namespace Subgraphs
+
+#include "mapped_file.inl"
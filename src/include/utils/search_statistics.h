@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Build with -DSUBGRAPHS_STATS=1 (CMake option SUBGRAPHS_STATS) to collect statistics of the
+// exact search. Without it, StatisticsRecorder is empty and the calls compile to nothing.
+#ifndef SUBGRAPHS_STATS
+#define SUBGRAPHS_STATS 0
+#endif
+
+namespace Subgraphs {
+
+inline constexpr bool SEARCH_STATISTICS_ENABLED = SUBGRAPHS_STATS != 0;
+
+// A new best extension found by the exact search
+struct IncumbentImprovement {
+    double milliseconds{}; // Since the start of run_exact
+    uint64_t cost{};
+    uint64_t nodesExplored{};
+};
+
+// What the exact search did, to explain why one instance takes much longer than another.
+// Filled through ExactOptions::statistics when SEARCH_STATISTICS_ENABLED.
+struct SearchStatistics {
+    uint64_t embeddingsComputed{};        // Phase 1: (permutation, vertex subset) pairs
+    uint64_t phase1TableBytes{};          // Heap memory of the Phase 1 missing-edge table
+    uint64_t embeddingsMerged{};          // Phase 2: missing-edge lists merged into configurations
+    uint64_t combinationSetsVisited{};    // Sets of n vertex subsets reached by the search
+    uint64_t combinationSetsPruned{};     // ... skipped because a standalone cost is too high
+    uint64_t configurationsVisited{};     // Permutation sequences evaluated
+    uint64_t configurationsPrunedEarly{}; // ... abandoned before the last copy (currentSize >=
+                                          // best size)
+    std::vector<IncumbentImprovement> improvements;
+
+    // Human-readable summary, one value per line
+    void print(std::ostream& out) const;
+};
+
+// Counts events of one search and adds them to a SearchStatistics in flush(). The counters
+// are plain members, so recording costs an increment and no check for a missing target.
+template <bool Enabled = SEARCH_STATISTICS_ENABLED> class StatisticsRecorder {
+  public:
+    explicit StatisticsRecorder(SearchStatistics* statistics) : target(statistics) {}
+
+    template <typename Table> void phase1Table(const Table& missingEdges);
+    void embeddingMerged() { ++counts.embeddingsMerged; }
+    void combinationSetVisited() { ++counts.combinationSetsVisited; }
+    void combinationSetPruned() { ++counts.combinationSetsPruned; }
+    void configurationVisited() { ++counts.configurationsVisited; }
+    void configurationPrunedEarly() { ++counts.configurationsPrunedEarly; }
+    void incumbentImproved(std::chrono::steady_clock::time_point searchStart, uint64_t cost,
+                           uint64_t nodesExplored);
+
+    void flush();
+
+  private:
+    SearchStatistics* target;
+    SearchStatistics counts;
+};
+
+template <> class StatisticsRecorder<false> {
+  public:
+    explicit StatisticsRecorder(SearchStatistics*) {}
+
+    template <typename Table> void phase1Table(const Table&) {}
+    void embeddingMerged() {}
+    void combinationSetVisited() {}
+    void combinationSetPruned() {}
+    void configurationVisited() {}
+    void configurationPrunedEarly() {}
+    void incumbentImproved(std::chrono::steady_clock::time_point, uint64_t, uint64_t) {}
+
+    void flush() {}
+};
+
+} // namespace Subgraphs
+
+#include "search_statistics.inl"
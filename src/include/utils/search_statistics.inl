@@ -0,0 +1,66 @@
+#include <iomanip>
+
+namespace Subgraphs {
+
+inline void SearchStatistics::print(std::ostream& out) const {
+    auto percent = [](uint64_t part, uint64_t whole) {
+        return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+    };
+    out << "=== Search Statistics ===\n";
+    out << "Phase 1 embeddings:       " << embeddingsComputed << " (table " << phase1TableBytes
+        << " bytes)\n";
+    out << "Combination sets visited: " << combinationSetsVisited << " (pruned by bound "
+        << combinationSetsPruned << ")\n";
+    out << "Configurations visited:   " << configurationsVisited << " (pruned early "
+        << configurationsPrunedEarly << ", " << std::fixed << std::setprecision(1)
+        << percent(configurationsPrunedEarly, configurationsVisited) << "%)\n";
+    out << "Embeddings merged:        " << embeddingsMerged << '\n';
+    out << "Incumbent improvements:   " << improvements.size() << '\n';
+    for (const auto& improvement : improvements) {
+        out << "  " << std::setprecision(3) << improvement.milliseconds << " ms: cost "
+            << improvement.cost << " after " << improvement.nodesExplored << " nodes\n";
+    }
+    out << std::defaultfloat << std::setprecision(6) << std::flush;
+}
+
+template <bool Enabled>
+template <typename Table>
+void StatisticsRecorder<Enabled>::phase1Table(const Table& missingEdges) {
+    // missingEdges[permutation][combination] = vector of edges
+    uint64_t bytes = missingEdges.capacity() * sizeof(missingEdges[0]);
+    for (const auto& row : missingEdges) {
+        bytes += row.capacity() * sizeof(row[0]);
+        for (const auto& edges : row) {
+            bytes += edges.capacity() * sizeof(edges[0]);
+        }
+        counts.embeddingsComputed += row.size();
+    }
+    counts.phase1TableBytes += bytes;
+}
+
+template <bool Enabled>
+void StatisticsRecorder<Enabled>::incumbentImproved(
+    std::chrono::steady_clock::time_point searchStart, uint64_t cost, uint64_t nodesExplored) {
+    const double milliseconds = std::chrono::duration<double, std::milli>(
+                                    std::chrono::steady_clock::now() - searchStart)
+                                    .count();
+    counts.improvements.push_back({milliseconds, cost, nodesExplored});
+}
+
+template <bool Enabled> void StatisticsRecorder<Enabled>::flush() {
+    if (target == nullptr) {
+        return;
+    }
+    target->embeddingsComputed += counts.embeddingsComputed;
+    target->phase1TableBytes += counts.phase1TableBytes;
+    target->embeddingsMerged += counts.embeddingsMerged;
+    target->combinationSetsVisited += counts.combinationSetsVisited;
+    target->combinationSetsPruned += counts.combinationSetsPruned;
+    target->configurationsVisited += counts.configurationsVisited;
+    target->configurationsPrunedEarly += counts.configurationsPrunedEarly;
+    target->improvements.insert(target->improvements.end(), counts.improvements.begin(),
+                                counts.improvements.end());
+    counts = SearchStatistics{};
+}
+
+} // namespace Subgraphs
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "../algorithms/subgraph_algorithm.h"
+#include "../graph/edge.h"
+
+namespace Subgraphs {
+
+/**
+ * Result of One Shard of a Sharded Exact Search
+ *
+ * `subgraphs <input> <n> exact --shard i/m --shard-result <file>` writes one of these per
+ * shard; `subgraphs merge <file>...` combines them. Shards run as independent processes
+ * (on one machine or spread by a batch scheduler) and only share the input graphs.
+ *
+ * File layout (text, one field per line):
+ *   subgraphs-shard 1
+ *   fingerprint <hash of P, G, n and the warm start>
+ *   subgraphs <n>
+ *   vertices <|V_G|>
+ *   shard <index> <count>
+ *   optimal <0|1>
+ *   nodes <nodes explored>
+ *   lower_bound <proven lower bound>
+ *   initial_cost <incumbent cost when the search started>
+ *   cost <cost of the extension>
+ *   extension <edge count>
+ *   <source> <destination> <count>   (one line per edge)
+ */
+template <typename IndexType = int64_t> struct ShardResult {
+    uint64_t fingerprint{};
+    int subgraphs{1};
+    uint64_t vertexCount{}; // |V_G|; the extension only names vertices below it
+    uint64_t shardIndex{0};
+    uint64_t shardCount{1};
+    bool optimal{};         // The shard finished: no combination set of it is cheaper
+    uint64_t nodesExplored{};
+    uint64_t lowerBound{};
+    uint64_t initialCost{};
+    uint64_t cost{};
+    std::vector<Edge<IndexType>> extension;
+
+    static ShardResult fromSearch(int subgraphs, uint64_t vertexCount,
+                                  const ExactOptions& options, const ExactSearchStats& stats,
+                                  std::vector<Edge<IndexType>> extension);
+    ExactSearchStats stats() const;
+
+    // Written through "<path>.tmp", synced and renamed, like ExactCheckpoint
+    void save(const std::filesystem::path& path) const;
+    static ShardResult load(const std::filesystem::path& path);
+
+    // Combines the results of shards 0..m-1 of one problem into the result of the whole
+    // search (shard 0/1): the cheapest extension, the smallest lower bound and the total
+    // node count. It is optimal only if every shard finished. Throws if the shards belong
+    // to different problems, or a shard is missing or given twice.
+    static ShardResult merge(const std::vector<ShardResult>& shards);
+};
+
+} // namespace Subgraphs
+
+#include "shard_result.inl"
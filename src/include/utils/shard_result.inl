@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "exact_checkpoint.h"
+
+namespace Subgraphs {
+
+inline constexpr const char* SHARD_RESULT_MAGIC = "subgraphs-shard";
+inline constexpr int SHARD_RESULT_VERSION = 1;
+
+template <typename IndexType>
+ShardResult<IndexType> ShardResult<IndexType>::fromSearch(int subgraphs, uint64_t vertexCount,
+                                                          const ExactOptions& options,
+                                                          const ExactSearchStats& stats,
+                                                          std::vector<Edge<IndexType>> extension) {
+    ShardResult result;
+    result.fingerprint = stats.fingerprint;
+    result.subgraphs = subgraphs;
+    result.vertexCount = vertexCount;
+    result.shardIndex = options.shardIndex;
+    result.shardCount = options.shardCount;
+    result.optimal = stats.optimal;
+    result.nodesExplored = stats.nodesExplored;
+    result.lowerBound = stats.lowerBound;
+    result.initialCost = stats.initialCost;
+    result.cost = stats.cost;
+    result.extension = std::move(extension);
+    return result;
+}
+
+template <typename IndexType> ExactSearchStats ShardResult<IndexType>::stats() const {
+    ExactSearchStats stats;
+    stats.cost = cost;
+    stats.lowerBound = lowerBound;
+    stats.nodesExplored = nodesExplored;
+    stats.initialCost = initialCost;
+    stats.optimal = optimal;
+    stats.fingerprint = fingerprint;
+    return stats;
+}
+
+template <typename IndexType>
+void ShardResult<IndexType>::save(const std::filesystem::path& path) const {
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Could not write shard result: " + temporary.string());
+        }
+        out << SHARD_RESULT_MAGIC << ' ' << SHARD_RESULT_VERSION << '\n';
+        out << "fingerprint " << fingerprint << '\n';
+        out << "subgraphs " << subgraphs << '\n';
+        out << "vertices " << vertexCount << '\n';
+        out << "shard " << shardIndex << ' ' << shardCount << '\n';
+        out << "optimal " << (optimal ? 1 : 0) << '\n';
+        out << "nodes " << nodesExplored << '\n';
+        out << "lower_bound " << lowerBound << '\n';
+        out << "initial_cost " << initialCost << '\n';
+        out << "cost " << cost << '\n';
+        writeExtensionRecord(out, extension);
+        if (!out.flush()) {
+            throw std::runtime_error("Could not write shard result: " + temporary.string());
+        }
+    }
+    replaceDurably(temporary, path, "shard result");
+}
+
+template <typename IndexType>
+ShardResult<IndexType> ShardResult<IndexType>::load(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open shard result: " + path.string());
+    }
+
+    auto fail = [&path](const std::string& field) {
+        throw std::runtime_error("Invalid shard result (" + field + "): " + path.string());
+    };
+    auto readField = [&](const char* key, auto& value) {
+        std::string word;
+        if (!(in >> word) || word != key || !(in >> value)) {
+            fail(key);
+        }
+    };
+
+    ShardResult result;
+    int version = 0;
+    readField(SHARD_RESULT_MAGIC, version);
+    if (version != SHARD_RESULT_VERSION) {
+        fail("version");
+    }
+    readField("fingerprint", result.fingerprint);
+    readField("subgraphs", result.subgraphs);
+    readField("vertices", result.vertexCount);
+    if (result.vertexCount == 0 ||
+        result.vertexCount > static_cast<uint64_t>(std::numeric_limits<IndexType>::max())) {
+        fail("vertices");
+    }
+    readField("shard", result.shardIndex);
+    if (!(in >> result.shardCount) || result.shardIndex >= result.shardCount) {
+        fail("shard");
+    }
+    int optimal = 0;
+    readField("optimal", optimal);
+    result.optimal = optimal != 0;
+    readField("nodes", result.nodesExplored);
+    readField("lower_bound", result.lowerBound);
+    readField("initial_cost", result.initialCost);
+    readField("cost", result.cost);
+    std::string word;
+    if (!(in >> word) || word != "extension") {
+        fail("extension");
+    }
+    auto extension = readExtensionRecord<IndexType>(in, result.cost, result.vertexCount);
+    if (!extension) {
+        fail("extension");
+    }
+    result.extension = std::move(*extension);
+    return result;
+}
+
+template <typename IndexType>
+ShardResult<IndexType> ShardResult<IndexType>::merge(const std::vector<ShardResult>& shards) {
+    if (shards.empty()) {
+        throw std::invalid_argument("No shard results to merge");
+    }
+    const ShardResult& first = shards.front();
+    for (const auto& shard : shards) {
+        if (shard.fingerprint != first.fingerprint || shard.subgraphs != first.subgraphs ||
+            shard.vertexCount != first.vertexCount || shard.shardCount != first.shardCount) {
+            throw std::invalid_argument("Shard results belong to different problems");
+        }
+        if (shard.shardIndex >= shard.shardCount) {
+            throw std::invalid_argument("Invalid shard " + std::to_string(shard.shardIndex) +
+                                        "/" + std::to_string(shard.shardCount));
+        }
+    }
+    // The count comes from the files; check it before sizing anything by it
+    if (first.shardCount > shards.size()) {
+        throw std::invalid_argument("Expected " + std::to_string(first.shardCount) +
+                                    " shard results, got " + std::to_string(shards.size()));
+    }
+    std::vector<bool> seen(static_cast<size_t>(first.shardCount), false);
+    for (const auto& shard : shards) {
+        if (seen[shard.shardIndex]) {
+            throw std::invalid_argument("Shard " + std::to_string(shard.shardIndex) + "/" +
+                                        std::to_string(shard.shardCount) + " given twice");
+        }
+        seen[shard.shardIndex] = true;
+    }
+    const auto missing = std::find(seen.begin(), seen.end(), false);
+    if (missing != seen.end()) {
+        throw std::invalid_argument("Missing shard " + std::to_string(missing - seen.begin()) +
+                                    "/" + std::to_string(first.shardCount));
+    }
+
+    // Ties go to the lowest shard index, so the merged extension does not depend on the
+    // order of the files
+    const ShardResult* best = &first;
+    for (const auto& shard : shards) {
+        if (shard.cost < best->cost ||
+            (shard.cost == best->cost && shard.shardIndex < best->shardIndex)) {
+            best = &shard;
+        }
+    }
+
+    ShardResult merged;
+    merged.fingerprint = first.fingerprint;
+    merged.subgraphs = first.subgraphs;
+    merged.vertexCount = first.vertexCount;
+    merged.optimal = true;
+    merged.lowerBound = first.lowerBound;
+    merged.initialCost = first.initialCost;
+    for (const auto& shard : shards) {
+        merged.optimal = merged.optimal && shard.optimal;
+        merged.nodesExplored += shard.nodesExplored;
+        merged.lowerBound = std::min(merged.lowerBound, shard.lowerBound);
+    }
+    merged.cost = best->cost;
+    merged.extension = best->extension;
+    return merged;
+}
+
+} // namespace Subgraphs
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Subgraphs {
+
+class ThreadPool {
+  public:
+    explicit ThreadPool(size_t threadCount = defaultThreadCount());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    template <typename Function>
+    std::future<std::invoke_result_t<Function>> submit(Function&& task);
+
+    // Splits [0, count) into contiguous chunks and runs body(chunkBegin, chunkEnd) for each
+    // chunk on the pool, blocking until all chunks are done. Chunk boundaries depend only on
+    // `count` and `chunkCount`, so callers can write results to fixed positions and stay
+    // deterministic regardless of scheduling.
+    template <typename Function>
+    void parallelFor(size_t count, size_t chunkCount, Function&& body);
+
+    size_t size() const;
+
+    static size_t defaultThreadCount();
+
+  private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping{false};
+};
+
+} // namespace Subgraphs
+
+#include "thread_pool.inl"
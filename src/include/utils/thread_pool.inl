@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <memory>
+
+namespace Subgraphs {
+
+inline ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+template <typename Function>
+std::future<std::invoke_result_t<Function>> ThreadPool::submit(Function&& task) {
+    using ResultType = std::invoke_result_t<Function>;
+
+    // std::function requires a copyable callable, so the packaged task lives behind a shared_ptr
+    auto packaged =
+        std::make_shared<std::packaged_task<ResultType()>>(std::forward<Function>(task));
+    std::future<ResultType> result = packaged->get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.emplace([packaged] { (*packaged)(); });
+    }
+    condition.notify_one();
+    return result;
+}
+
+template <typename Function>
+void ThreadPool::parallelFor(size_t count, size_t chunkCount, Function&& body) {
+    chunkCount = std::max<size_t>(1, std::min(chunkCount, count));
+    if (chunkCount == 1) {
+        body(size_t{0}, count);
+        return;
+    }
+
+    std::vector<std::future<void>> chunks;
+    chunks.reserve(chunkCount);
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        const size_t begin = count * chunk / chunkCount;
+        const size_t end = count * (chunk + 1) / chunkCount;
+        chunks.push_back(submit([&body, begin, end] { body(begin, end); }));
+    }
+    // Wait for every chunk before rethrowing, so no task outlives `body`
+    for (auto& chunk : chunks) {
+        chunk.wait();
+    }
+    for (auto& chunk : chunks) {
+        chunk.get();
+    }
+}
+
+inline size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+inline size_t ThreadPool::defaultThreadCount() {
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 0 ? static_cast<size_t>(hardwareThreads) : 1;
+}
+
+inline void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+} // namespace Subgraphs
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace Subgraphs {
+
+/**
+ * Timeline of Solver Phases in Chrome Trace Event Format
+ *
+ * TraceSpan objects mark scopes (parsing, Phase 1, chunks of the exact search, weight
+ * matrices, Hungarian solves, ...). Once Trace::enable() is called, every span becomes a
+ * complete event ("ph":"X") on the timeline of its thread; Trace::write produces JSON for
+ * chrome://tracing or ui.perfetto.dev.
+ *
+ * Cost: while tracing is disabled a span is a single atomic load. When enabled it
+ * reads the clock twice and appends to a buffer owned by the calling thread, so threads
+ * never contend on the hot path. Spans are placed around units of work of microseconds or
+ * more, never around single configurations.
+ */
+class Trace {
+  public:
+    Trace() = delete;
+
+    // Starts recording; the timeline starts at the first call
+    static void enable();
+    static bool enabled() { return active.load(std::memory_order_acquire); }
+
+    // Adds a complete event to the calling thread's buffer. `name`, `category` and `argName`
+    // must be string literals (they are stored as pointers); argName may be null.
+    static void record(const char* name, const char* category,
+                       std::chrono::steady_clock::time_point begin,
+                       std::chrono::steady_clock::time_point end, const char* argName,
+                       int64_t argValue);
+
+    // Writes {"traceEvents":[...]} with the events of all threads. Call it once the traced
+    // work has finished; threads still recording are not synchronized with.
+    static void write(std::ostream& out);
+    static void writeToFile(const std::filesystem::path& path);
+
+    // Drops all recorded events and disables tracing
+    static void reset();
+
+  private:
+    struct Event {
+        const char* name;
+        const char* category;
+        const char* argName;
+        int64_t argValue;
+        int64_t beginNs; // Since `origin`
+        int64_t durationNs;
+    };
+    // Shared with the global list so events outlive the thread that recorded them
+    struct ThreadBuffer {
+        uint32_t threadId;
+        std::vector<Event> events;
+    };
+
+    static ThreadBuffer& threadBuffer();
+
+    static inline std::atomic<bool> active{false};
+    static inline std::chrono::steady_clock::time_point origin;
+    static inline std::mutex buffersMutex;
+    static inline std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    static inline std::atomic<uint64_t> generation{0}; // Bumped by reset()
+};
+
+// Records the lifetime of the object as one event when tracing is enabled
+class TraceSpan {
+  public:
+    explicit TraceSpan(const char* eventName, const char* eventCategory = "solver",
+                       const char* eventArgName = nullptr, int64_t eventArgValue = 0);
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    ~TraceSpan();
+
+  private:
+    const char* name;
+    const char* category;
+    const char* argName;
+    int64_t argValue;
+    bool recording;
+    std::chrono::steady_clock::time_point begin;
+};
+
+} // namespace Subgraphs
+
+#include "trace.inl"
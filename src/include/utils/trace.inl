@@ -0,0 +1,125 @@
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "json_output.h"
+
+namespace Subgraphs {
+
+inline void Trace::enable() {
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        if (!active.load(std::memory_order_relaxed)) {
+            origin = std::chrono::steady_clock::now();
+            active.store(true, std::memory_order_release);
+        }
+    }
+    // The enabling thread is registered first, so it is shown as "main"
+    threadBuffer();
+}
+
+inline Trace::ThreadBuffer& Trace::threadBuffer() {
+    // Re-registered after reset(), which drops the old buffers
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    thread_local uint64_t bufferGeneration = 0;
+    const uint64_t current = generation.load(std::memory_order_acquire);
+    if (!buffer || bufferGeneration != current) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->threadId = static_cast<uint32_t>(buffers.size() + 1);
+        buffers.push_back(buffer);
+        bufferGeneration = current;
+    }
+    return *buffer;
+}
+
+inline void Trace::record(const char* name, const char* category,
+                          std::chrono::steady_clock::time_point begin,
+                          std::chrono::steady_clock::time_point end, const char* argName,
+                          int64_t argValue) {
+    auto nanoseconds = [](std::chrono::steady_clock::duration duration) {
+        return static_cast<int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    };
+    threadBuffer().events.push_back(
+        {name, category, argName, argValue, nanoseconds(begin - origin), nanoseconds(end - begin)});
+}
+
+inline void Trace::write(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    // Timestamps are in microseconds; keep nanosecond precision as decimals
+    auto microseconds = [](int64_t nanoseconds) {
+        return std::to_string(nanoseconds / 1000) + "." +
+               std::to_string(1000 + nanoseconds % 1000).substr(1);
+    };
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&] {
+        if (!first) {
+            json += ",\n";
+        }
+        first = false;
+    };
+    for (const auto& buffer : buffers) {
+        const std::string tid = std::to_string(buffer->threadId);
+        separate();
+        json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid +
+                ",\"args\":{\"name\":";
+        appendJsonString(json, buffer->threadId == 1 ? "main" : "thread " + tid);
+        json += "}}";
+        for (const auto& event : buffer->events) {
+            separate();
+            json += "{\"name\":";
+            appendJsonString(json, event.name);
+            json += ",\"cat\":";
+            appendJsonString(json, event.category);
+            json += ",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid;
+            json += ",\"ts\":" + microseconds(event.beginNs);
+            json += ",\"dur\":" + microseconds(event.durationNs);
+            if (event.argName != nullptr) {
+                json += ",\"args\":{";
+                appendJsonString(json, event.argName);
+                json += ":" + std::to_string(event.argValue) + "}";
+            }
+            json += "}";
+        }
+    }
+    json += "]}\n";
+    out << json;
+}
+
+inline void Trace::writeToFile(const std::filesystem::path& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Could not write trace: " + path.string());
+    }
+    write(out);
+    if (!out.flush()) {
+        throw std::runtime_error("Could not write trace: " + path.string());
+    }
+}
+
+inline void Trace::reset() {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    active.store(false, std::memory_order_relaxed);
+    buffers.clear();
+    generation.fetch_add(1, std::memory_order_release);
+}
+
+inline TraceSpan::TraceSpan(const char* eventName, const char* eventCategory,
+                            const char* eventArgName, int64_t eventArgValue)
+    : name(eventName), category(eventCategory), argName(eventArgName), argValue(eventArgValue),
+      recording(Trace::enabled()) {
+    if (recording) {
+        begin = std::chrono::steady_clock::now();
+    }
+}
+
+inline TraceSpan::~TraceSpan() {
+    if (recording) {
+        Trace::record(name, category, begin, std::chrono::steady_clock::now(), argName, argValue);
+    }
+}
+
+} // namespace Subgraphs
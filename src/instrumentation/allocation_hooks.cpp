@@ -0,0 +1,139 @@
+// Replacement global operator new/delete that feed AllocationTracker. Linked only into
+// executables that ask for it (the subgraphs_alloc_hooks target).
+//
+// Every block carries a header in front of the returned pointer that stores the requested
+// size, so unsized deletes know how many bytes they release. The header is as large as the
+// alignment, which keeps the returned pointer aligned.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#    include <malloc.h>
+#endif
+
+#include "utils/allocation_tracker.h"
+
+namespace {
+
+constexpr size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+const bool hooksInstalled = [] {
+    Subgraphs::AllocationTracker::markInstalled();
+    return true;
+}();
+
+void* allocateBlock(size_t total, size_t alignment) {
+#ifdef _WIN32
+    return _aligned_malloc(total, alignment);
+#else
+    if (alignment == DEFAULT_ALIGNMENT) {
+        return std::malloc(total);
+    }
+    // aligned_alloc wants a multiple of the alignment
+    if (total > SIZE_MAX - (alignment - 1)) {
+        return nullptr;
+    }
+    return std::aligned_alloc(alignment, (total + alignment - 1) / alignment * alignment);
+#endif
+}
+
+void freeBlock(void* block) {
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+
+void* allocate(size_t size, size_t alignment) {
+    alignment = alignment < DEFAULT_ALIGNMENT ? DEFAULT_ALIGNMENT : alignment;
+    // Adding the header must not wrap the total around to a tiny block
+    if (size > SIZE_MAX - alignment) {
+        return nullptr;
+    }
+    void* block = allocateBlock(alignment + (size == 0 ? 1 : size), alignment);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    char* user = static_cast<char*>(block) + alignment;
+    reinterpret_cast<size_t*>(user)[-1] = size;
+    Subgraphs::AllocationTracker::recordAllocation(size);
+    return user;
+}
+
+void* allocateOrThrow(size_t size, size_t alignment) {
+    while (true) {
+        if (void* user = allocate(size, alignment)) {
+            return user;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void release(void* user, size_t alignment) noexcept {
+    if (user == nullptr) {
+        return;
+    }
+    alignment = alignment < DEFAULT_ALIGNMENT ? DEFAULT_ALIGNMENT : alignment;
+    Subgraphs::AllocationTracker::recordDeallocation(reinterpret_cast<size_t*>(user)[-1]);
+    freeBlock(static_cast<char*>(user) - alignment);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size) { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, DEFAULT_ALIGNMENT);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, DEFAULT_ALIGNMENT);
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* user) noexcept { release(user, DEFAULT_ALIGNMENT); }
+void operator delete[](void* user) noexcept { release(user, DEFAULT_ALIGNMENT); }
+void operator delete(void* user, size_t) noexcept { release(user, DEFAULT_ALIGNMENT); }
+void operator delete[](void* user, size_t) noexcept { release(user, DEFAULT_ALIGNMENT); }
+void operator delete(void* user, const std::nothrow_t&) noexcept {
+    release(user, DEFAULT_ALIGNMENT);
+}
+void operator delete[](void* user, const std::nothrow_t&) noexcept {
+    release(user, DEFAULT_ALIGNMENT);
+}
+void operator delete(void* user, std::align_val_t alignment) noexcept {
+    release(user, static_cast<size_t>(alignment));
+}
+void operator delete[](void* user, std::align_val_t alignment) noexcept {
+    release(user, static_cast<size_t>(alignment));
+}
+void operator delete(void* user, size_t, std::align_val_t alignment) noexcept {
+    release(user, static_cast<size_t>(alignment));
+}
+void operator delete[](void* user, size_t, std::align_val_t alignment) noexcept {
+    release(user, static_cast<size_t>(alignment));
+}
+void operator delete(void* user, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    release(user, static_cast<size_t>(alignment));
+}
+void operator delete[](void* user, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    release(user, static_cast<size_t>(alignment));
+}
@@ -1,64 +1,458 @@
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <csignal>
 #include <iostream>
 
 #include "algorithms/subgraph_algorithm.h"
+#include "algorithms/exact_planner.h"
 #include "graph/multigraph.h"
 #include "utils/graph_loader.h"
 #include "algorithms/heuristic.h"
 #include "utils/graph_printer.h"
+#include "utils/batch_runner.h"
+#include "utils/shard_result.h"
+#include <fstream>
 
 using GRAPH_INDEX_TYPE = uint16_t;
 
+// Set by SIGINT/SIGTERM while a checkpointed or sharded exact search runs, so the search can
+// save its frontier and result and return instead of being killed
+static std::atomic<bool> stopRequested{false};
+static volatile std::sig_atomic_t stopSignal = 0;
+
+static void requestStop(int signal) {
+    stopSignal = signal;
+    stopRequested.store(true);
+}
+
+// subgraphs convert <input_file> <output_file> [binary|text|edges]
+// Reads a graph pair in any format and writes it in the requested one (binary by default).
+static int convertGraphFile(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " convert <input_file> <output_file> [binary|text|edges]" << std::endl;
+        return 1;
+    }
+
+    std::string outputFormat = argc >= 5 ? argv[4] : "binary";
+    if (outputFormat != "binary" && outputFormat != "text" && outputFormat != "edges") {
+        std::cerr << "Unknown output format: " << outputFormat << " (expected binary, text or edges)" << std::endl;
+        return 1;
+    }
+
+    try {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto [patternGraph, targetGraph] =
+            Subgraphs::GraphLoader<GRAPH_INDEX_TYPE>::loadFromFile(argv[2]);
+        if (outputFormat == "binary") {
+            Subgraphs::GraphLoader<GRAPH_INDEX_TYPE>::saveToBinaryFile(patternGraph, targetGraph,
+                                                                       argv[3]);
+        } else if (outputFormat == "edges") {
+            Subgraphs::GraphLoader<GRAPH_INDEX_TYPE>::saveToEdgeListFile(patternGraph, targetGraph,
+                                                                         argv[3]);
+        } else {
+            Subgraphs::GraphLoader<GRAPH_INDEX_TYPE>::saveToFile(patternGraph, targetGraph, {}, 0,
+                                                                 argv[3]);
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+        std::cout << "Converted " << argv[2] << " -> " << argv[3] << " (" << outputFormat << ", "
+                  << duration.count() << " ms)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// subgraphs batch [manifest_file|-] [threads]
+// Runs every job of the manifest (stdin when omitted or "-") and prints one JSON line per job.
+static int runBatch(int argc, char** argv) {
+    size_t threads = Subgraphs::ThreadPool::defaultThreadCount();
+    if (argc >= 4) {
+        try {
+            threads = static_cast<size_t>(std::stoul(argv[3]));
+        } catch (...) {
+            std::cerr << "Invalid number of threads: " << argv[3] << std::endl;
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t failures = 0;
+    std::string manifest = argc >= 3 ? argv[2] : "-";
+    if (manifest == "-") {
+        failures = Subgraphs::BatchRunner<GRAPH_INDEX_TYPE>::run(std::cin, std::cout, threads);
+    } else {
+        std::ifstream jobs(manifest);
+        if (!jobs.is_open()) {
+            std::cerr << "Could not open manifest: " << manifest << std::endl;
+            return 1;
+        }
+        failures = Subgraphs::BatchRunner<GRAPH_INDEX_TYPE>::run(jobs, std::cout, threads);
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+    std::cerr << "Batch finished in " << duration.count() << " ms, " << failures
+              << " failed job(s)" << std::endl;
+    return failures == 0 ? 0 : 2;
+}
+
+// subgraphs merge <shard_result>... [--format text|json|csv] [--quiet]
+// Combines the results of all shards of a sharded exact search into the global result.
+static int mergeShards(int argc, char** argv) {
+    Subgraphs::OutputFormat format = Subgraphs::OutputFormat::TEXT;
+    bool quiet = false;
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quiet") {
+            quiet = true;
+        } else if (arg == "--format") {
+            auto parsed = i + 1 < argc ? Subgraphs::parseOutputFormat(argv[++i]) : std::nullopt;
+            if (!parsed) {
+                std::cerr << "Invalid value for --format (expected text, json or csv)" << std::endl;
+                return 1;
+            }
+            format = *parsed;
+        } else {
+            files.push_back(std::move(arg));
+        }
+    }
+    if (files.empty()) {
+        std::cerr << "Usage: " << argv[0] << " merge <shard_result>... [--format text|json|csv] [--quiet]" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    try {
+        std::vector<Subgraphs::ShardResult<GRAPH_INDEX_TYPE>> shards;
+        for (const auto& file : files) {
+            shards.push_back(Subgraphs::ShardResult<GRAPH_INDEX_TYPE>::load(file));
+        }
+        auto merged = Subgraphs::ShardResult<GRAPH_INDEX_TYPE>::merge(shards);
+        const Subgraphs::ExactSearchStats stats = merged.stats();
+
+        if (format != Subgraphs::OutputFormat::TEXT) {
+            Subgraphs::RunReport<GRAPH_INDEX_TYPE> report;
+            report.subgraphs = merged.subgraphs;
+            report.extension = std::move(merged.extension);
+            report.exactStats = stats;
+            report.totalMs = std::chrono::duration<double, std::milli>(
+                                 std::chrono::high_resolution_clock::now() - start)
+                                 .count();
+            if (format == Subgraphs::OutputFormat::JSON) {
+                Subgraphs::GraphPrinter<GRAPH_INDEX_TYPE>::printJson(std::cout, report);
+            } else {
+                Subgraphs::GraphPrinter<GRAPH_INDEX_TYPE>::printCsv(std::cout, report);
+            }
+            return 0;
+        }
+
+        std::cout << "Merged " << shards.size() << " shard(s), " << stats.nodesExplored
+                  << " nodes: " << (stats.optimal ? "optimal" : "not finished") << ", cost "
+                  << stats.cost << ", lower bound " << stats.lowerBound << ", gap "
+                  << stats.gap() * 100.0 << "%" << std::endl;
+        if (quiet) {
+            std::cout << "Total extension cost: " << stats.cost << " edge(s)" << std::endl;
+        } else {
+            Subgraphs::GraphPrinter<GRAPH_INDEX_TYPE>::printExtension(merged.extension);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Writes the Chrome trace when main returns, on every exit path once tracing is enabled
+struct TraceFileWriter {
+    std::filesystem::path path;
+    ~TraceFileWriter() {
+        if (path.empty() || !Subgraphs::Trace::enabled()) {
+            return;
+        }
+        try {
+            Subgraphs::Trace::writeToFile(path);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+        }
+    }
+};
+
 int main(int argc, char** argv) {
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <input_graph_file> [num_subgraphs] [algorithm: exact|approx1|approx2] [heuristic: degree|directed|directed_ignore|histogram|structure|greedy]" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <input_graph_file> [num_subgraphs] [algorithm: exact|approx1|approx2|portfolio] [heuristic: degree|directed|directed_ignore|histogram|structure|greedy] [--format text|json|csv] [--quiet] [--time-limit seconds] [--warm-start approx1|approx2|portfolio] [--checkpoint file [--resume]] [--shard i/m [--shard-result file]] [--stats] [--trace file] [--streaming | --spill dir | --compact] [--dry-run] [--max-memory size [--fallback streaming|approx1|approx2|portfolio]]" << std::endl;
+        std::cerr << "       " << argv[0] << " convert <input_file> <output_file> [binary|text|edges]" << std::endl;
+        std::cerr << "       " << argv[0] << " batch [manifest_file|-] [threads]" << std::endl;
+        std::cerr << "       " << argv[0] << " merge <shard_result>... [--format text|json|csv] [--quiet]" << std::endl;
         return 1;
     }
 
+    if (std::string(argv[1]) == "convert") {
+        return convertGraphFile(argc, argv);
+    }
+    if (std::string(argv[1]) == "batch") {
+        return runBatch(argc, argv);
+    }
+    if (std::string(argv[1]) == "merge") {
+        return mergeShards(argc, argv);
+    }
+
+    // Options may appear anywhere; everything else is a positional argument
+    Subgraphs::OutputFormat format = Subgraphs::OutputFormat::TEXT;
+    bool quiet = false;
+    Subgraphs::ExactOptions exactOptions;
+    exactOptions.progress = &std::cerr;
+    std::filesystem::path shardResultPath;
+    Subgraphs::SearchStatistics statistics;
+    bool printStatistics = false;
+    TraceFileWriter traceWriter;
+    bool dryRun = false;
+    std::optional<uint64_t> maxMemory;
+    std::optional<Subgraphs::AlgorithmType> fallback;
+    bool fallbackStreaming = false;
+    int storageFlags = 0;
+    std::vector<std::string> exactOnlyFlags; // Given flags that only the exact search uses
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quiet") {
+            quiet = true;
+        } else if (arg == "--stats") {
+            exactOnlyFlags.push_back(arg);
+            if (!Subgraphs::SEARCH_STATISTICS_ENABLED) {
+                std::cerr << "--stats requires a build with statistics (cmake -DSUBGRAPHS_STATS=ON)" << std::endl;
+                return 1;
+            }
+            printStatistics = true;
+            exactOptions.statistics = &statistics;
+        } else if (arg == "--trace") {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for --trace (file)" << std::endl;
+                return 1;
+            }
+            traceWriter.path = argv[++i];
+        } else if (arg == "--dry-run") {
+            dryRun = true;
+        } else if (arg == "--streaming") {
+            exactOnlyFlags.push_back(arg);
+            exactOptions.storage = Subgraphs::MissingEdgeStorage::STREAMING;
+            storageFlags += 1;
+        } else if (arg == "--compact") {
+            exactOnlyFlags.push_back(arg);
+            exactOptions.storage = Subgraphs::MissingEdgeStorage::COMPACT;
+            storageFlags += 1;
+        } else if (arg == "--spill") {
+            exactOnlyFlags.push_back(arg);
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for --spill (directory)" << std::endl;
+                return 1;
+            }
+            exactOptions.storage = Subgraphs::MissingEdgeStorage::SPILLED;
+            exactOptions.spillDirectory = argv[++i];
+            storageFlags += 1;
+        } else if (arg == "--max-memory") {
+            exactOnlyFlags.push_back(arg);
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for --max-memory (size, e.g. 512M or 4G)" << std::endl;
+                return 1;
+            }
+            maxMemory = Subgraphs::parseMemorySize(argv[++i]);
+            if (!maxMemory) {
+                std::cerr << "Invalid memory size: " << argv[i] << " (e.g. 512M or 4G)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--fallback") {
+            exactOnlyFlags.push_back(arg);
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for --fallback (expected streaming, approx1, approx2 or portfolio)" << std::endl;
+                return 1;
+            }
+            const std::string value = argv[++i];
+            fallbackStreaming = value == "streaming";
+            fallback = fallbackStreaming ? std::nullopt : Subgraphs::parseAlgorithm(value);
+            if (!fallbackStreaming && (!fallback || *fallback == Subgraphs::AlgorithmType::EXACT)) {
+                std::cerr << "Invalid fallback: " << value << " (expected streaming, approx1, approx2 or portfolio)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--time-limit") {
+            exactOnlyFlags.push_back(arg);
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for --time-limit (seconds)" << std::endl;
+                return 1;
+            }
+            // A finite positive number with nothing after it ("nan", "inf" and "5abc" fail)
+            size_t parsed = 0;
+            try {
+                exactOptions.timeLimitSeconds = std::stod(argv[++i], &parsed);
+            } catch (...) {
+                std::cerr << "Invalid time limit: " << argv[i] << std::endl;
+                return 1;
+            }
+            if (argv[i][parsed] != '\0' || !std::isfinite(exactOptions.timeLimitSeconds) ||
+                exactOptions.timeLimitSeconds <= 0.0) {
+                std::cerr << "Invalid time limit: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--checkpoint") {
+            exactOnlyFlags.push_back(arg);
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for --checkpoint (file)" << std::endl;
+                return 1;
+            }
+            exactOptions.checkpointPath = argv[++i];
+        } else if (arg == "--resume") {
+            exactOnlyFlags.push_back(arg);
+            exactOptions.resume = true;
+        } else if (arg == "--shard") {
+            exactOnlyFlags.push_back(arg);
+            // i/m with 0 <= i < m
+            const std::string value = i + 1 < argc ? argv[++i] : "";
+            const size_t slash = value.find('/');
+            try {
+                if (slash == std::string::npos) {
+                    throw std::invalid_argument(value);
+                }
+                exactOptions.shardIndex = std::stoull(value.substr(0, slash));
+                exactOptions.shardCount = std::stoull(value.substr(slash + 1));
+            } catch (...) {
+                exactOptions.shardCount = 0;
+            }
+            if (exactOptions.shardCount == 0 ||
+                exactOptions.shardIndex >= exactOptions.shardCount) {
+                std::cerr << "Invalid shard: " << value << " (expected i/m with 0 <= i < m)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--shard-result") {
+            exactOnlyFlags.push_back(arg);
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for --shard-result (file)" << std::endl;
+                return 1;
+            }
+            shardResultPath = argv[++i];
+        } else if (arg == "--warm-start") {
+            exactOnlyFlags.push_back(arg);
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for --warm-start (expected approx1, approx2 or portfolio)" << std::endl;
+                return 1;
+            }
+            auto parsed = Subgraphs::parseAlgorithm(argv[++i]);
+            if (!parsed || *parsed == Subgraphs::AlgorithmType::EXACT) {
+                std::cerr << "Invalid warm start: " << argv[i] << " (expected approx1, approx2 or portfolio)" << std::endl;
+                return 1;
+            }
+            exactOptions.warmStart = *parsed;
+        } else if (arg == "--format" || arg.rfind("--format=", 0) == 0) {
+            std::string formatStr;
+            if (arg == "--format") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Missing value for --format (expected text, json or csv)" << std::endl;
+                    return 1;
+                }
+                formatStr = argv[++i];
+            } else {
+                formatStr = arg.substr(std::string("--format=").size());
+            }
+            auto parsed = Subgraphs::parseOutputFormat(formatStr);
+            if (!parsed) {
+                std::cerr << "Unknown output format: " << formatStr << " (expected text, json or csv)" << std::endl;
+                return 1;
+            }
+            format = *parsed;
+        } else {
+            args.push_back(std::move(arg));
+        }
+    }
+    if (args.empty()) {
+        std::cerr << "Missing input graph file" << std::endl;
+        return 1;
+    }
+    if (exactOptions.resume && exactOptions.checkpointPath.empty()) {
+        std::cerr << "--resume requires --checkpoint <file>" << std::endl;
+        return 1;
+    }
+    if ((fallback || fallbackStreaming) && !maxMemory) {
+        std::cerr << "--fallback requires --max-memory <size>" << std::endl;
+        return 1;
+    }
+    // Machine-readable formats never print the banner or the matrices
+    const bool textOutput = format == Subgraphs::OutputFormat::TEXT;
+    const bool verbose = textOutput && !quiet;
+
     int subgraphsCount = 1;
-    if (argc >= 3) {
+    if (args.size() >= 2) {
         try {
-            subgraphsCount = std::stoi(argv[2]);
+            subgraphsCount = std::stoi(args[1]);
         } catch (...) {
-            std::cerr << "Invalid number of subgraphs: " << argv[2] << std::endl;
+            std::cerr << "Invalid number of subgraphs: " << args[1] << std::endl;
             return 1;
         }
     }
 
     std::string algorithm = "exact";
-    if (argc >= 4) {
-        algorithm = argv[3];
+    if (args.size() >= 3) {
+        algorithm = args[2];
+    }
+    auto algorithmType = Subgraphs::parseAlgorithm(algorithm);
+    if (!algorithmType) {
+        std::cerr << "Unknown algorithm: " << algorithm << std::endl;
+        return 1;
+    }
+    // The other algorithms would silently ignore these
+    if (!exactOnlyFlags.empty() && *algorithmType != Subgraphs::AlgorithmType::EXACT) {
+        std::string flags;
+        for (const auto& flag : exactOnlyFlags) {
+            flags += (flags.empty() ? "" : ", ") + flag;
+        }
+        std::cerr << flags << (exactOnlyFlags.size() == 1 ? " only applies" : " only apply")
+                  << " to the exact algorithm" << std::endl;
+        return 1;
+    }
+    if (storageFlags > 1) {
+        std::cerr << "--streaming, --spill and --compact cannot be combined" << std::endl;
+        return 1;
     }
 
     Subgraphs::HeuristicType heuristic = Subgraphs::HeuristicType::DEGREE_DIFFERENCE;
-    if (argc >= 5) {
-        std::string heuristicStr = argv[4];
-        if (heuristicStr == "degree") {
-            heuristic = Subgraphs::HeuristicType::DEGREE_DIFFERENCE;
-        } else if (heuristicStr == "directed") {
-            heuristic = Subgraphs::HeuristicType::DIRECTED_DEGREE;
-        } else if (heuristicStr == "directed_ignore") {
-            heuristic = Subgraphs::HeuristicType::DIRECTED_DEGREE_IGNORE_SURPLUS;
-        } else if (heuristicStr == "histogram") {
-            heuristic = Subgraphs::HeuristicType::NEIGHBOR_HISTOGRAM;
-        } else if (heuristicStr == "structure") {
-            heuristic = Subgraphs::HeuristicType::STRUCTURE_MATCHING;
-        } else if (heuristicStr == "greedy") {
-            heuristic = Subgraphs::HeuristicType::GREEDY_NEIGHBOR;
-        } else {
+    if (args.size() >= 4) {
+        std::string heuristicStr = args[3];
+        auto parsed = Subgraphs::parseHeuristic(heuristicStr);
+        if (!parsed) {
             std::cerr << "Unknown heuristic: " << heuristicStr << std::endl;
             std::cerr << "Available heuristics: degree, directed, directed_ignore, histogram, structure, greedy" << std::endl;
             return 1;
         }
+        heuristic = *parsed;
+    }
+
+    if (!traceWriter.path.empty()) {
+        Subgraphs::Trace::enable();
+    }
+
+    std::string inputGraphFile = args[0];
+
+    Subgraphs::RunReport<GRAPH_INDEX_TYPE> report;
+    report.file = inputGraphFile;
+    report.subgraphs = subgraphsCount;
+    report.algorithm = *algorithmType;
+    if (report.algorithm == Subgraphs::AlgorithmType::APPROX2) {
+        report.heuristic = heuristic;
     }
 
-    std::string inputGraphFile = argv[1];
+    // An interrupted search still prints its incumbent, but exits like the signal would have
+    auto exitCode = [] { return stopSignal != 0 ? 128 + static_cast<int>(stopSignal) : 0; };
 
     auto start = std::chrono::high_resolution_clock::now();
     try {
-        std::cout << "Loading graphs from: " << inputGraphFile << "\n" << std::endl;
+        if (verbose) {
+            std::cout << "Loading graphs from: " << inputGraphFile << "\n" << std::endl;
+        }
         auto [patternGraph, targetGraph] =
             Subgraphs::GraphLoader<GRAPH_INDEX_TYPE>::loadFromFile(inputGraphFile);
+        report.timings.loadMs = std::chrono::duration<double, std::milli>(
+                                    std::chrono::high_resolution_clock::now() - start)
+                                    .count();
 
         if (targetGraph.combinationsCount(patternGraph.getVertexCount()) < subgraphsCount) {
             std::cerr << "Error: Target graph does not have enough vertices to host "
@@ -66,33 +460,192 @@ int main(int argc, char** argv) {
             return 1;
         }
 
-        std::cout << "=== Running Subgraph Algorithm ===" << std::endl;
-        std::cout << "Algorithm: " << algorithm << std::endl;
-        if (algorithm == "approx2") {
-            std::cout << "Heuristic: " << static_cast<int>(heuristic) << std::endl;
+        // Plan the exact search before Phase 1 allocates its table
+        if (report.algorithm == Subgraphs::AlgorithmType::EXACT || dryRun) {
+            const auto plan =
+                Subgraphs::planExact(subgraphsCount, patternGraph, targetGraph);
+            const bool exact = report.algorithm == Subgraphs::AlgorithmType::EXACT;
+            bool streaming = exactOptions.storage == Subgraphs::MissingEdgeStorage::STREAMING;
+            const bool spilled = exactOptions.storage == Subgraphs::MissingEdgeStorage::SPILLED;
+            const bool compact = exactOptions.storage == Subgraphs::MissingEdgeStorage::COMPACT;
+            // A streaming search gets whatever the budget leaves for its cache
+            if (maxMemory) {
+                const uint64_t reserved = plan.streamingFixedBytes + plan.phase2Bytes;
+                exactOptions.streamingCacheBytes = *maxMemory > reserved ? *maxMemory - reserved : 0;
+            }
+            const uint64_t streamingPeak = plan.streamingPeakBytes(exactOptions.streamingCacheBytes);
+            auto overBudget = [&](uint64_t bytes, const std::string& what) {
+                return maxMemory && bytes > *maxMemory
+                           ? "estimated peak memory " + what + Subgraphs::formatMemorySize(bytes) +
+                                 " exceeds --max-memory " + Subgraphs::formatMemorySize(*maxMemory)
+                           : std::string();
+            };
+            std::string refusal;
+            if (!plan.fitsIndexType) {
+                refusal = "the search space does not fit the index type";
+            } else if (streaming) {
+                refusal = overBudget(streamingPeak, "of the streaming search ");
+            } else if (spilled) {
+                // The mapped table is page cache, which the kernel reclaims under pressure
+                refusal = overBudget(plan.spilledPeakBytes(), "of the spilled search ");
+            } else if (compact) {
+                refusal = overBudget(plan.compactPeakBytes(), "with the compact table ");
+            } else {
+                refusal = overBudget(plan.peakBytes(), "");
+            }
+            auto streamingRun = [&] {
+                return "run exact with streaming missing edges (cache " +
+                       Subgraphs::formatMemorySize(exactOptions.streamingCacheBytes) + ")";
+            };
+            std::string decision =
+                exact && streaming ? streamingRun()
+                : exact && spilled
+                    ? "run exact with the Phase 1 table spilled to " +
+                          exactOptions.spillDirectory.string() + " (" +
+                          Subgraphs::formatMemorySize(plan.spillFileBytes) + " on disk)"
+                : exact && compact
+                    ? "run exact with the compact Phase 1 table (" +
+                          Subgraphs::formatMemorySize(plan.compactBytes) + ")"
+                    : "run " + std::string(Subgraphs::algorithmName(report.algorithm));
+            bool downgraded = false;
+            if (exact && !refusal.empty()) {
+                if (fallbackStreaming && !streaming && !spilled && plan.fitsIndexType &&
+                    overBudget(streamingPeak, "").empty()) {
+                    decision = streamingRun() + " instead of the Phase 1 table: " + refusal;
+                    exactOptions.storage = Subgraphs::MissingEdgeStorage::STREAMING;
+                    refusal.clear();
+                    downgraded = true;
+                } else if (fallbackStreaming && !spilled && plan.fitsIndexType) {
+                    refusal += " and the streaming search needs at least " +
+                               Subgraphs::formatMemorySize(plan.streamingPeakBytes(0));
+                    decision = "refuse exact: " + refusal;
+                } else if (fallback) {
+                    decision = "run " + std::string(Subgraphs::algorithmName(*fallback)) +
+                               " instead of exact: " + refusal;
+                } else {
+                    decision = "refuse exact: " + refusal;
+                }
+            }
+            if (dryRun) {
+                std::cout << "=== Exact Plan (k=" << patternGraph.getVertexCount()
+                          << ", N=" << targetGraph.getVertexCount() << ", n=" << subgraphsCount
+                          << ") ===" << std::endl;
+                plan.print(std::cout);
+                std::cout << "Decision: " << decision << std::endl;
+                return exact && !refusal.empty() && !fallback ? 1 : 0;
+            }
+            if (downgraded) {
+                std::cerr << "Note: " << decision << std::endl;
+            }
+            if (!refusal.empty()) {
+                if (!fallback) {
+                    std::cerr << "Error: " << refusal
+                              << " (use --fallback streaming|approx1|approx2|portfolio or a larger budget)"
+                              << std::endl;
+                    return 1;
+                }
+                if (exactOptions.shardCount > 1 || !shardResultPath.empty()) {
+                    std::cerr << "Error: " << refusal << " (a shard cannot fall back)" << std::endl;
+                    return 1;
+                }
+                std::cerr << "Note: " << decision << std::endl;
+                report.algorithm = *fallback;
+                algorithm = std::string(Subgraphs::algorithmName(*fallback));
+                if (report.algorithm == Subgraphs::AlgorithmType::APPROX2) {
+                    report.heuristic = heuristic;
+                }
+            }
+        }
+
+        if (verbose) {
+            std::cout << "=== Running Subgraph Algorithm ===" << std::endl;
+            std::cout << "Algorithm: " << algorithm << std::endl;
+            if (algorithm == "approx2") {
+                std::cout << "Heuristic: " << static_cast<int>(heuristic) << std::endl;
+            }
         }
 
         std::vector<Subgraphs::Edge<GRAPH_INDEX_TYPE>> result;
-        if (algorithm == "exact") {
-            result = Subgraphs::SubgraphAlgorithm<GRAPH_INDEX_TYPE>::run(
-                subgraphsCount, patternGraph, targetGraph);
-        } else if (algorithm == "approx2") {
-            result = Subgraphs::SubgraphAlgorithm<GRAPH_INDEX_TYPE>::run_approx_v2(
-                subgraphsCount, patternGraph, targetGraph, heuristic);
-        } else if (algorithm == "approx1") {
-            result = Subgraphs::SubgraphAlgorithm<GRAPH_INDEX_TYPE>::run_approx_v1(
-                subgraphsCount, patternGraph, targetGraph);
+        if (report.algorithm == Subgraphs::AlgorithmType::PORTFOLIO) {
+            std::vector<Subgraphs::PortfolioEntry<GRAPH_INDEX_TYPE>> members;
+            result = Subgraphs::SubgraphAlgorithm<GRAPH_INDEX_TYPE>::run_portfolio(
+                subgraphsCount, patternGraph, targetGraph, &members);
+
+            if (textOutput) {
+                std::cout << "\n=== Portfolio Members ===" << std::endl;
+                for (const auto& member : members) {
+                    std::cout << "  " << member.name << ": cost " << member.cost << ", "
+                              << member.milliseconds << " ms" << std::endl;
+                }
+                auto best = std::min_element(members.begin(), members.end(),
+                                             [](const auto& a, const auto& b) { return a.cost < b.cost; });
+                std::cout << "Best member: " << best->name << std::endl;
+            }
+        } else if (report.algorithm == Subgraphs::AlgorithmType::EXACT) {
+            if (!exactOptions.checkpointPath.empty() || !shardResultPath.empty()) {
+                exactOptions.stopRequested = &stopRequested;
+                std::signal(SIGINT, requestStop);
+                std::signal(SIGTERM, requestStop);
+            }
+            Subgraphs::ExactSearchStats stats;
+            result = Subgraphs::SubgraphAlgorithm<GRAPH_INDEX_TYPE>::run_exact(
+                subgraphsCount, patternGraph, targetGraph, exactOptions, &stats, &report.timings);
+            report.exactStats = stats;
+            if (printStatistics) {
+                statistics.print(std::cerr);
+            }
+            if (!shardResultPath.empty()) {
+                Subgraphs::ShardResult<GRAPH_INDEX_TYPE>::fromSearch(
+                    subgraphsCount, static_cast<uint64_t>(targetGraph.getVertexCount()),
+                    exactOptions, stats, result)
+                    .save(shardResultPath);
+            }
+
+            if (textOutput && exactOptions.shardCount > 1) {
+                std::cout << "\nShard " << exactOptions.shardIndex << "/"
+                          << exactOptions.shardCount << ": " << stats.nodesExplored
+                          << " nodes, best cost " << stats.cost
+                          << (stats.optimal ? " (shard finished)" : "") << std::endl;
+            }
+            if (textOutput && !stats.optimal) {
+                std::cout << "\n" << (stopSignal != 0 ? "Interrupted" : "Time limit reached")
+                          << " after " << stats.nodesExplored
+                          << " nodes: best cost " << stats.cost << ", lower bound "
+                          << stats.lowerBound << ", gap " << stats.gap() * 100.0 << "%"
+                          << std::endl;
+            }
         } else {
-            std::cerr << "Unknown algorithm: " << algorithm << std::endl;
-            return 1;
+            result = Subgraphs::SubgraphAlgorithm<GRAPH_INDEX_TYPE>::run_algorithm(
+                report.algorithm, subgraphsCount, patternGraph, targetGraph, heuristic,
+                &report.timings);
+        }
+
+        if (!textOutput) {
+            report.extension = std::move(result);
+            report.totalMs = std::chrono::duration<double, std::milli>(
+                                 std::chrono::high_resolution_clock::now() - start)
+                                 .count();
+            if (format == Subgraphs::OutputFormat::JSON) {
+                Subgraphs::GraphPrinter<GRAPH_INDEX_TYPE>::printJson(std::cout, report);
+            } else {
+                Subgraphs::GraphPrinter<GRAPH_INDEX_TYPE>::printCsv(std::cout, report);
+            }
+            return exitCode();
         }
 
         if (result.empty()) {
             std::cout << "No extensions needed." << std::endl;
-            return 0;
+            return exitCode();
         }
 
-        Subgraphs::GraphPrinter<GRAPH_INDEX_TYPE>::printResults(patternGraph, targetGraph, result);
+        if (quiet) {
+            std::cout << "Total extension cost: "
+                      << Subgraphs::SubgraphAlgorithm<GRAPH_INDEX_TYPE>::extensionCost(result)
+                      << " edge(s)" << std::endl;
+        } else {
+            Subgraphs::GraphPrinter<GRAPH_INDEX_TYPE>::printResults(patternGraph, targetGraph,
+                                                                    result);
+        }
 
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -102,5 +655,5 @@ int main(int argc, char** argv) {
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     std::cout << "\nExecution time: " << duration.count() << " ms" << std::endl;
 
-    return 0;
+    return exitCode();
 }
@@ -0,0 +1,135 @@
+// Linked with subgraphs_alloc_hooks, so every operator new/delete of this test is counted
+#include "algorithms/subgraph_algorithm.h"
+#include "graph/combination_iterator.h"
+#include "graph/multigraph.h"
+#include "graph/sequence_iterator.h"
+#include "utils/allocation_tracker.h"
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace Subgraphs;
+
+namespace {
+
+Multigraph<int32_t> cycle(size_t vertices, size_t chordStep) {
+    std::vector<std::vector<uint8_t>> matrix(vertices, std::vector<uint8_t>(vertices, 0));
+    for (size_t i = 0; i < vertices; ++i) {
+        matrix[i][(i + 1) % vertices] = 1;
+        matrix[i][(i + chordStep) % vertices] = 2;
+    }
+    return Multigraph<int32_t>(std::move(matrix));
+}
+
+// Binomial coefficient for small arguments
+uint64_t choose(uint64_t n, uint64_t k) {
+    uint64_t result = 1;
+    for (uint64_t i = 1; i <= k; ++i) {
+        result = result * (n - k + i) / i;
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(AllocationTrackerTest, HooksAreInstalled) {
+    EXPECT_TRUE(AllocationTracker::hooksInstalled());
+}
+
+TEST(AllocationTrackerTest, CountsAllocationsAndBytes) {
+    AllocationScope scope;
+    auto values = std::make_unique<std::vector<int>>(100);
+    const AllocationCounts during = scope.counts();
+    EXPECT_EQ(during.allocations, 2u);
+    EXPECT_GE(during.bytes, sizeof(std::vector<int>) + 100 * sizeof(int));
+    EXPECT_EQ(during.peakBytes, during.bytes);
+
+    values.reset();
+    const AllocationCounts after = scope.counts();
+    EXPECT_EQ(after.deallocations, 2u);
+    EXPECT_EQ(after.peakBytes, during.bytes);
+}
+
+TEST(AllocationTrackerTest, HugeRequestsThrowBadAlloc) {
+    // Sizes near SIZE_MAX used to wrap around once the size header was added
+    volatile size_t huge = SIZE_MAX - 4;
+    AllocationScope scope;
+    EXPECT_THROW(static_cast<void>(::operator new(huge)), std::bad_alloc);
+    EXPECT_THROW(static_cast<void>(::operator new(huge, std::align_val_t{64})),
+                 std::bad_alloc);
+    EXPECT_EQ(::operator new(huge, std::nothrow), nullptr);
+    EXPECT_EQ(scope.counts().allocations, 0u);
+}
+
+TEST(AllocationTrackerTest, NestedScopeKeepsOuterPeak) {
+    AllocationScope outer;
+    auto large = std::make_unique<char[]>(4096);
+    large.reset();
+    {
+        AllocationScope inner;
+        auto small = std::make_unique<char[]>(16);
+        EXPECT_EQ(inner.counts().peakBytes, 16u);
+    }
+    EXPECT_GE(outer.counts().peakBytes, 4096u);
+}
+
+// Allocation budgets of the hot paths
+
+TEST(AllocationTrackerTest, IteratorsDoNotAllocatePerStep) {
+    // Only the begin and end iterators own a vector, however many steps are taken
+    AllocationScope combinations;
+    uint64_t steps = 0;
+    for (const auto& combination : CombinationRange<int32_t>(20, 3)) {
+        steps += combination.size() > 0 ? 1 : 0;
+    }
+    EXPECT_EQ(steps, choose(20, 3));
+    EXPECT_LE(combinations.counts().allocations, 2u);
+
+    AllocationScope sequences;
+    steps = 0;
+    for (const auto& sequence : SequenceRange<int32_t>(6, 4)) {
+        steps += sequence.size() > 0 ? 1 : 0;
+    }
+    EXPECT_EQ(steps, 6u * 6u * 6u * 6u);
+    EXPECT_LE(sequences.counts().allocations, 2u);
+}
+
+TEST(AllocationTrackerTest, PhaseOneAllocatesOncePerEmbedding) {
+    auto P = cycle(3, 2);
+    auto G = cycle(8, 3);
+    const uint64_t embeddings =
+        static_cast<uint64_t>(P.permutationsCount()) *
+        static_cast<uint64_t>(G.combinationsCount(P.getVertexCount()));
+
+    AllocationScope scope;
+    auto missingEdges = SubgraphAlgorithm<int32_t>::getAllMissingEdges(P, G);
+    // One edge list per embedding, one row per permutation, the table and a few scratch
+    // vectors
+    EXPECT_LE(scope.counts().allocations, embeddings + P.permutationsCount() + 32u);
+}
+
+TEST(AllocationTrackerTest, PhaseTwoDoesNotAllocatePerConfiguration) {
+    auto P = cycle(3, 2);
+    auto G = cycle(8, 3);
+    const int copies = 2;
+    const auto missingEdges = SubgraphAlgorithm<int32_t>::getAllMissingEdges(P, G);
+
+    AllocationScope scope;
+    ExactSearchStats stats;
+    SubgraphAlgorithm<int32_t>::findMinimalExtension(copies, P, G, missingEdges, ExactOptions{},
+                                                     SubgraphAlgorithm<int32_t>::Clock::now(),
+                                                     stats);
+    // Every combination set may start a permutation sequence range (two vectors); the
+    // configurations inside it must not allocate
+    const uint64_t combinationSets = choose(G.combinationsCount(P.getVertexCount()), copies);
+    const uint64_t allocations = scope.counts().allocations;
+    EXPECT_LE(allocations, 2 * combinationSets + 64u);
+    EXPECT_GT(stats.nodesExplored, combinationSets);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+#include "utils/batch_runner.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace Subgraphs;
+
+class BatchRunnerTest : public ::testing::Test {
+  protected:
+    std::string graphFile = "test_batch_graph_temp.txt";
+
+    void SetUp() override {
+        std::ofstream file(graphFile);
+        file << "2\n0 1\n0 0\n4\n0 0 0 0\n0 0 1 0\n0 0 0 0\n1 0 0 0\n";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(graphFile);
+    }
+
+    static std::vector<std::string> lines(const std::string& text) {
+        std::vector<std::string> result;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) {
+            result.push_back(line);
+        }
+        return result;
+    }
+};
+
+TEST_F(BatchRunnerTest, ParsePositionalJob) {
+    auto job = BatchRunner<int32_t>::parseJob("  graphs.txt 3 approx2 histogram");
+    ASSERT_TRUE(job.has_value());
+    EXPECT_EQ(job->file, "graphs.txt");
+    EXPECT_EQ(job->subgraphs, 3);
+    EXPECT_EQ(job->algorithm, AlgorithmType::APPROX2);
+    EXPECT_EQ(job->heuristic, HeuristicType::NEIGHBOR_HISTOGRAM);
+
+    auto defaults = BatchRunner<int32_t>::parseJob("graphs.txt");
+    ASSERT_TRUE(defaults.has_value());
+    EXPECT_EQ(defaults->subgraphs, 1);
+    EXPECT_EQ(defaults->algorithm, AlgorithmType::EXACT);
+}
+
+TEST_F(BatchRunnerTest, ParseJsonJob) {
+    auto job = BatchRunner<int32_t>::parseJob(
+        R"({"id": "run \"7\"", "file": "dir/g.txt", "n": 2, "algorithm": "approx1", "x": true})");
+    ASSERT_TRUE(job.has_value());
+    EXPECT_EQ(job->id, "run \"7\"");
+    EXPECT_EQ(job->file, "dir/g.txt");
+    EXPECT_EQ(job->subgraphs, 2);
+    EXPECT_EQ(job->algorithm, AlgorithmType::APPROX1);
+}
+
+TEST_F(BatchRunnerTest, ParseSkipsBlankAndCommentLines) {
+    EXPECT_FALSE(BatchRunner<int32_t>::parseJob("").has_value());
+    EXPECT_FALSE(BatchRunner<int32_t>::parseJob("   \r").has_value());
+    EXPECT_FALSE(BatchRunner<int32_t>::parseJob("# comment").has_value());
+}
+
+TEST_F(BatchRunnerTest, ParseRejectsMalformedJobs) {
+    EXPECT_THROW(BatchRunner<int32_t>::parseJob("g.txt two"), std::runtime_error);
+    EXPECT_THROW(BatchRunner<int32_t>::parseJob("g.txt 1 fastest"), std::runtime_error);
+    EXPECT_THROW(BatchRunner<int32_t>::parseJob(R"({"n": 1})"), std::runtime_error);
+    EXPECT_THROW(BatchRunner<int32_t>::parseJob(R"({"file": "g.txt")"), std::runtime_error);
+    EXPECT_THROW(BatchRunner<int32_t>::parseJob(R"({"file": ["g.txt"]})"), std::runtime_error);
+}
+
+TEST_F(BatchRunnerTest, RunStreamsOneResultPerJobAndReusesGraphs) {
+    std::istringstream jobs("# jobs\n" + graphFile + " 1 approx1\n" +
+                            R"({"file": ")" + graphFile +
+                            R"(", "n": 1, "algorithm": "approx2", "id": "second"})" + "\n");
+    std::ostringstream results;
+
+    const size_t failures = BatchRunner<int32_t>::run(jobs, results, 1);
+
+    EXPECT_EQ(failures, 0u);
+    auto output = lines(results.str());
+    ASSERT_EQ(output.size(), 2u);
+    // One worker runs the jobs in manifest order; the second job finds the graphs cached
+    EXPECT_NE(output[0].find("\"job\":2"), std::string::npos);
+    EXPECT_NE(output[0].find("\"status\":\"success\""), std::string::npos);
+    EXPECT_NE(output[0].find("\"cached\":false"), std::string::npos);
+    EXPECT_NE(output[1].find("\"id\":\"second\""), std::string::npos);
+    EXPECT_NE(output[1].find("\"heuristic\":\"degree\""), std::string::npos);
+    EXPECT_NE(output[1].find("\"cached\":true"), std::string::npos);
+    EXPECT_NE(output[1].find("\"cost\":1"), std::string::npos);
+}
+
+TEST_F(BatchRunnerTest, RunReportsFailedJobsAndContinues) {
+    std::istringstream jobs("missing_file.txt 1 approx1\n" + graphFile + " 1 nonsense\n" +
+                            graphFile + " 100 approx1\n" + graphFile + " 1 approx1\n");
+    std::ostringstream results;
+
+    const size_t failures = BatchRunner<int32_t>::run(jobs, results, 2);
+
+    EXPECT_EQ(failures, 3u);
+    auto output = lines(results.str());
+    ASSERT_EQ(output.size(), 4u);
+    size_t errors = 0;
+    for (const auto& line : output) {
+        errors += line.find("\"status\":\"error\"") != std::string::npos ? 1 : 0;
+    }
+    EXPECT_EQ(errors, 3u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
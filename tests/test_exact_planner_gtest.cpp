@@ -0,0 +1,119 @@
+#include "algorithms/exact_planner.h"
+#include "algorithms/subgraph_algorithm.h"
+#include "graph/multigraph.h"
+#include "test_graphs.h"
+#include <sstream>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace Subgraphs;
+using SubgraphsTest::randomGraph;
+
+template <typename T> class ExactPlannerTest : public ::testing::Test {};
+
+using PlannerTypes = ::testing::Types<int32_t, int64_t>;
+TYPED_TEST_SUITE(ExactPlannerTest, PlannerTypes);
+
+TYPED_TEST(ExactPlannerTest, CountsMatchTheSearchSpace) {
+    auto P = randomGraph<TypeParam>(3, 2, 1);
+    auto G = randomGraph<TypeParam>(7, 2, 2);
+    const ExactPlan plan = planExact(2, P, G);
+
+    EXPECT_EQ(plan.embeddings, 6u * 35u);
+    EXPECT_DOUBLE_EQ(plan.combinationSets, 35.0 * 34.0 / 2.0);
+    EXPECT_DOUBLE_EQ(plan.configurations, plan.combinationSets * 36.0);
+    EXPECT_TRUE(plan.fitsIndexType);
+}
+
+TYPED_TEST(ExactPlannerTest, MissingEdgesMatchPhaseOne) {
+    // Loops and multi-edges on both sides exercise both histograms
+    for (uint32_t seed = 0; seed < 5; ++seed) {
+        auto P = randomGraph<TypeParam>(4, 3, 10 + seed);
+        auto G = randomGraph<TypeParam>(8, 3, 20 + seed);
+        const ExactPlan plan = planExact(1, P, G);
+
+        const auto table = SubgraphAlgorithm<TypeParam>::getAllMissingEdges(P, G);
+        size_t missingEdges = 0;
+        size_t lists = 0;
+        for (const auto& row : table) {
+            for (const auto& list : row) {
+                missingEdges += list.size();
+                lists += 1;
+            }
+        }
+        EXPECT_EQ(lists, plan.embeddings);
+        EXPECT_DOUBLE_EQ(plan.missingEdges, static_cast<double>(missingEdges)) << "seed " << seed;
+
+        // The estimate covers the table's own storage and leaves room for the allocator
+        const uint64_t tableBytes = table.size() * sizeof(table[0]) +
+                                    lists * sizeof(table[0][0]) +
+                                    missingEdges * sizeof(Edge<TypeParam>);
+        EXPECT_GE(plan.phase1Bytes, tableBytes);
+        EXPECT_LE(plan.phase1Bytes, tableBytes * 2);
+    }
+}
+
+TEST(ExactPlannerTest, StreamingKeepsAtLeastOneRowPerCopy) {
+    auto P = randomGraph<int32_t>(4, 2, 30);
+    auto G = randomGraph<int32_t>(9, 2, 31);
+    const ExactPlan plan = planExact(3, P, G);
+    const uint64_t base = plan.streamingFixedBytes + plan.phase2Bytes;
+
+    EXPECT_EQ(plan.streamingPeakBytes(0), base + 3 * plan.streamingRowBytes);
+    EXPECT_EQ(plan.streamingPeakBytes(10 * plan.streamingRowBytes),
+              base + 10 * plan.streamingRowBytes);
+    // No more rows than vertex subsets
+    EXPECT_EQ(plan.streamingPeakBytes(UINT64_MAX / 2), base + 126 * plan.streamingRowBytes);
+    EXPECT_LT(plan.streamingPeakBytes(0), plan.peakBytes());
+}
+
+TEST(ExactPlannerTest, ReportsTablesBeyondTheIndexType) {
+    // 9! = 362880 permutations cannot be indexed with uint16_t
+    Multigraph<uint16_t> P(std::vector<std::vector<uint8_t>>(9, std::vector<uint8_t>(9, 1)));
+    Multigraph<uint16_t> G(std::vector<std::vector<uint8_t>>(10, std::vector<uint8_t>(10, 0)));
+    const ExactPlan plan = planExact(1, P, G);
+    EXPECT_FALSE(plan.fitsIndexType);
+    EXPECT_EQ(plan.embeddings, 362880u * 10u);
+
+    std::ostringstream out;
+    plan.print(out);
+    EXPECT_NE(out.str().find("Index type"), std::string::npos);
+}
+
+TEST(ExactPlannerTest, HugeInstancesSaturate) {
+    Multigraph<int64_t> P(std::vector<std::vector<uint8_t>>(12, std::vector<uint8_t>(12, 1)));
+    Multigraph<int64_t> G(std::vector<std::vector<uint8_t>>(60, std::vector<uint8_t>(60, 0)));
+    const ExactPlan plan = planExact(3, P, G);
+    EXPECT_EQ(plan.peakBytes(), std::numeric_limits<uint64_t>::max());
+    EXPECT_GT(plan.phase2Seconds, 1e9);
+}
+
+TEST(ExactPlannerTest, ParsesMemorySizes) {
+    EXPECT_EQ(parseMemorySize("100000"), 100000u);
+    EXPECT_EQ(parseMemorySize("64K"), 64u * 1024u);
+    EXPECT_EQ(parseMemorySize("512M"), 512u * 1024u * 1024u);
+    EXPECT_EQ(parseMemorySize("512MB"), 512u * 1024u * 1024u);
+    EXPECT_EQ(parseMemorySize("4g"), 4ull << 30);
+    EXPECT_EQ(parseMemorySize("4GiB"), 4ull << 30);
+    EXPECT_EQ(parseMemorySize("1.5G"), 3ull << 29);
+    EXPECT_EQ(parseMemorySize("2T"), 2ull << 40);
+
+    EXPECT_FALSE(parseMemorySize(""));
+    EXPECT_FALSE(parseMemorySize("G"));
+    EXPECT_FALSE(parseMemorySize("0"));
+    EXPECT_FALSE(parseMemorySize("-1G"));
+    EXPECT_FALSE(parseMemorySize("4X"));
+    EXPECT_FALSE(parseMemorySize("1.2.3M"));
+}
+
+TEST(ExactPlannerTest, FormatsMemorySizes) {
+    EXPECT_EQ(formatMemorySize(512), "512 B");
+    EXPECT_EQ(formatMemorySize(1536), "1.5 KiB");
+    EXPECT_EQ(formatMemorySize(3ull << 30), "3 GiB");
+    EXPECT_EQ(formatMemorySize(100ull << 20), "100 MiB");
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,5 +1,6 @@
 #include "graph/multigraph.h"
 #include "utils/graph_loader.h"
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <gtest/gtest.h>
@@ -146,6 +147,325 @@ TYPED_TEST(GraphLoaderTest, LoadGraphPreservesEdgeCounts) {
     EXPECT_EQ(target.getEdges(1, 2), 3);
 }
 
+TYPED_TEST(GraphLoaderTest, LoadSkipsLeadingLinesAndCarriageReturns) {
+    this->createTestFile("# pattern\r\n\r\n2\r\n0 4\r\n1 0\r\n\r\n3\r\n0 1 0\r\n0 0 2\r\n7 0 0");
+
+    auto [pattern, target] = GraphLoader<TypeParam>::loadFromFile(this->testFilePath);
+
+    EXPECT_EQ(pattern.getVertexCount(), 2);
+    EXPECT_EQ(pattern.getEdges(0, 1), 4);
+    EXPECT_EQ(pattern.getEdges(1, 0), 1);
+    EXPECT_EQ(target.getVertexCount(), 3);
+    EXPECT_EQ(target.getEdges(1, 2), 2);
+    EXPECT_EQ(target.getEdges(2, 0), 7);
+    EXPECT_EQ(target.getEdgeCount(), 10);
+}
+
+TYPED_TEST(GraphLoaderTest, MalformedRowReportsLineNumber) {
+    this->createTestFile(R"(2
+0 1
+1 0
+3
+0 1 0
+0 x 2
+1 0 0
+)");
+
+    try {
+        GraphLoader<TypeParam>::loadFromFile(this->testFilePath);
+        FAIL() << "Expected std::runtime_error";
+    } catch (const std::runtime_error& e) {
+        const std::string message = e.what();
+        EXPECT_NE(message.find("Malformed second matrix row"), std::string::npos);
+        EXPECT_NE(message.find("(line 6)"), std::string::npos);
+    }
+}
+
+TYPED_TEST(GraphLoaderTest, TruncatedMatrixThrows) {
+    this->createTestFile(R"(2
+0 1
+1 0
+1000
+0 1 0
+)");
+
+    EXPECT_THROW(GraphLoader<TypeParam>::loadFromFile(this->testFilePath), std::runtime_error);
+}
+
+TYPED_TEST(GraphLoaderTest, MissingSecondMatrixThrows) {
+    this->createTestFile(R"(2
+0 1
+1 0
+)");
+
+    EXPECT_THROW(GraphLoader<TypeParam>::loadFromFile(this->testFilePath), std::runtime_error);
+}
+
+TYPED_TEST(GraphLoaderTest, BinaryRoundTripDenseIsZeroCopy) {
+    Multigraph<TypeParam> g1(std::vector<std::vector<uint8_t>>{{0, 1, 2}, {0, 0, 1}, {1, 0, 0}});
+    Multigraph<TypeParam> g2(std::vector<std::vector<uint8_t>>{{0, 3}, {1, 0}});
+
+    GraphLoader<TypeParam>::saveToBinaryFile(g1, g2, this->testFilePath, BinaryEncoding::DENSE);
+    EXPECT_TRUE(GraphLoader<TypeParam>::isBinaryFile(this->testFilePath));
+
+    auto [pattern, target] = GraphLoader<TypeParam>::loadFromFile(this->testFilePath);
+
+    EXPECT_TRUE(pattern.isView());
+    EXPECT_TRUE(target.isView());
+    EXPECT_EQ(pattern.getAdjacencyMatrix(), g2.getAdjacencyMatrix());
+    EXPECT_EQ(target.getAdjacencyMatrix(), g1.getAdjacencyMatrix());
+    EXPECT_EQ(target.getEdgeCount(), g1.getEdgeCount());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(target.data()) % BINARY_PAYLOAD_ALIGNMENT, 0u);
+
+    // Modifying a view copies it and leaves the other graph untouched
+    target.addEdges(0, 0, 4);
+    EXPECT_FALSE(target.isView());
+    EXPECT_EQ(target.getEdges(0, 0), 4);
+    EXPECT_EQ(target.getEdges(0, 2), 2);
+    EXPECT_TRUE(pattern.isView());
+}
+
+TYPED_TEST(GraphLoaderTest, BinaryRoundTripSparse) {
+    Multigraph<TypeParam> g1(std::vector<std::vector<uint8_t>>{{0, 1, 0, 0}, {0, 0, 0, 0},
+                                                               {0, 0, 0, 9}, {0, 0, 0, 0}});
+    Multigraph<TypeParam> g2(std::vector<std::vector<uint8_t>>{{0, 2}, {0, 0}});
+
+    GraphLoader<TypeParam>::saveToBinaryFile(g1, g2, this->testFilePath, BinaryEncoding::SPARSE);
+    auto [pattern, target] = GraphLoader<TypeParam>::loadFromFile(this->testFilePath);
+
+    EXPECT_FALSE(target.isView());
+    EXPECT_EQ(target.getAdjacencyMatrix(), g1.getAdjacencyMatrix());
+    EXPECT_EQ(target.getEdgeCount(), 10);
+    EXPECT_EQ(pattern.getAdjacencyMatrix(), g2.getAdjacencyMatrix());
+}
+
+TYPED_TEST(GraphLoaderTest, BinaryCorruptPayloadThrows) {
+    Multigraph<TypeParam> g1(std::vector<std::vector<uint8_t>>{{0, 1}, {1, 0}});
+    Multigraph<TypeParam> g2(std::vector<std::vector<uint8_t>>{{0, 1, 0}, {0, 0, 1}, {1, 0, 0}});
+    GraphLoader<TypeParam>::saveToBinaryFile(g1, g2, this->testFilePath);
+
+    {
+        std::fstream file(this->testFilePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(sizeof(BinaryGraphHeader)));
+        file.put(7);
+    }
+
+    EXPECT_THROW(GraphLoader<TypeParam>::loadFromFile(this->testFilePath), std::runtime_error);
+}
+
+TYPED_TEST(GraphLoaderTest, BinaryCorruptHeaderCountThrows) {
+    Multigraph<TypeParam> g1(std::vector<std::vector<uint8_t>>{{0, 1}, {1, 0}});
+    Multigraph<TypeParam> g2(std::vector<std::vector<uint8_t>>{{0, 1, 0}, {0, 0, 1}, {1, 0, 0}});
+    GraphLoader<TypeParam>::saveToBinaryFile(g1, g2, this->testFilePath);
+
+    // The payloads are intact; only the stored edge count of the first graph is wrong
+    {
+        std::fstream file(this->testFilePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(offsetof(BinaryGraphHeader, graphs) +
+                                               offsetof(BinaryGraphSection, edgeCount)));
+        file.put(99);
+    }
+
+    EXPECT_THROW(GraphLoader<TypeParam>::loadFromFile(this->testFilePath), std::runtime_error);
+}
+
+TYPED_TEST(GraphLoaderTest, TextFileIsNotBinary) {
+    this->createTestFile("1\n0\n1\n0\n");
+    EXPECT_FALSE(GraphLoader<TypeParam>::isBinaryFile(this->testFilePath));
+}
+
+TYPED_TEST(GraphLoaderTest, LoadEdgeListSections) {
+    this->createTestFile(R"(# pattern
+edges 2
+0 1
+1 0 3
+
+# target
+edges 4
+0 1 2
+2 3
+2 3
+)");
+
+    auto [pattern, target] = GraphLoader<TypeParam>::loadFromFile(this->testFilePath);
+
+    EXPECT_EQ(pattern.getVertexCount(), 2);
+    EXPECT_EQ(pattern.getEdges(0, 1), 1);
+    EXPECT_EQ(pattern.getEdges(1, 0), 3);
+    EXPECT_EQ(target.getVertexCount(), 4);
+    EXPECT_EQ(target.getEdges(0, 1), 2);
+    EXPECT_EQ(target.getEdges(2, 3), 2);
+    EXPECT_EQ(target.getEdgeCount(), 4);
+}
+
+TYPED_TEST(GraphLoaderTest, LoadMatrixPatternWithEdgeListTarget) {
+    this->createTestFile(R"(2
+0 1
+0 0
+edges 3
+1 2 5
+)");
+
+    auto [pattern, target] = GraphLoader<TypeParam>::loadFromFile(this->testFilePath);
+
+    EXPECT_EQ(pattern.getEdges(0, 1), 1);
+    EXPECT_EQ(target.getVertexCount(), 3);
+    EXPECT_EQ(target.getEdges(1, 2), 5);
+}
+
+TYPED_TEST(GraphLoaderTest, LoadEdgeListPatternWithMatrixTarget) {
+    this->createTestFile(R"(edges 2
+0 1
+3
+0 1 0
+0 0 1
+1 0 0
+)");
+
+    auto [pattern, target] = GraphLoader<TypeParam>::loadFromFile(this->testFilePath);
+
+    EXPECT_EQ(pattern.getVertexCount(), 2);
+    EXPECT_EQ(pattern.getEdges(0, 1), 1);
+    EXPECT_EQ(target.getVertexCount(), 3);
+    EXPECT_EQ(target.getEdges(2, 0), 1);
+}
+
+TYPED_TEST(GraphLoaderTest, EdgeListVertexOutOfRangeThrows) {
+    this->createTestFile(R"(edges 2
+0 1
+edges 3
+0 3
+)");
+
+    EXPECT_THROW(GraphLoader<TypeParam>::loadFromFile(this->testFilePath), std::runtime_error);
+}
+
+TYPED_TEST(GraphLoaderTest, EdgeListBadCountReportsLineNumber) {
+    // Neither an unparsable nor an out-of-range count may fall back to a single edge
+    for (const char* edge : {"0 1 abc", "0 1 99999999999"}) {
+        this->createTestFile(std::string("edges 2\n0 1\nedges 3\n1 2\n") + edge + "\n");
+        try {
+            GraphLoader<TypeParam>::loadFromFile(this->testFilePath);
+            FAIL() << "Expected std::runtime_error for " << edge;
+        } catch (const std::runtime_error& e) {
+            const std::string message = e.what();
+            EXPECT_NE(message.find("Malformed second matrix edge"), std::string::npos) << edge;
+            EXPECT_NE(message.find("(line 5)"), std::string::npos) << edge;
+        }
+    }
+}
+
+// A size the index type cannot hold must not be truncated (300 would become 44 in uint8_t)
+class NarrowIndexLoaderTest : public GraphLoaderTest<uint8_t> {};
+
+TEST_F(NarrowIndexLoaderTest, VertexCountBeyondIndexTypeThrows) {
+    for (const char* target : {"edges 300\n0 1\n", "300\n"}) {
+        this->createTestFile(std::string("edges 2\n0 1\n") + target);
+        try {
+            GraphLoader<uint8_t>::loadFromFile(this->testFilePath);
+            FAIL() << "Expected std::runtime_error for " << target;
+        } catch (const std::runtime_error& e) {
+            const std::string message = e.what();
+            EXPECT_NE(message.find("Vertex count 300 of second matrix"), std::string::npos)
+                << message;
+            EXPECT_NE(message.find("(line 3)"), std::string::npos) << message;
+        }
+    }
+}
+
+TYPED_TEST(GraphLoaderTest, EdgeListRoundTrip) {
+    Multigraph<TypeParam> g1(std::vector<std::vector<uint8_t>>{{0, 1, 2}, {0, 0, 1}, {1, 0, 0}});
+    Multigraph<TypeParam> g2(std::vector<std::vector<uint8_t>>{{0, 3}, {1, 0}});
+
+    GraphLoader<TypeParam>::saveToEdgeListFile(g1, g2, this->testFilePath);
+    auto [pattern, target] = GraphLoader<TypeParam>::loadFromFile(this->testFilePath);
+
+    EXPECT_EQ(pattern.getAdjacencyMatrix(), g2.getAdjacencyMatrix());
+    EXPECT_EQ(target.getAdjacencyMatrix(), g1.getAdjacencyMatrix());
+}
+
+// Large enough to take the parallel row-block path (given more than one thread)
+std::string largeMatrixText(int n, int badRow) {
+    std::string text = std::to_string(n) + "\n";
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            text += (i == badRow && j == n / 2) ? "x" : std::to_string((i + j) % 3);
+            text += j + 1 < n ? " " : "\n";
+        }
+    }
+    return text;
+}
+
+TYPED_TEST(GraphLoaderTest, LoadLargeMatrixInParallel) {
+    constexpr int n = 1100;
+    this->createTestFile("1\n0\n" + largeMatrixText(n, -1));
+
+    auto [pattern, target] = GraphLoader<TypeParam>::loadFromFile(this->testFilePath, 4);
+
+    ASSERT_EQ(target.getVertexCount(), n);
+    for (int i = 0; i < n; i += 37) {
+        for (int j = 0; j < n; j += 13) {
+            ASSERT_EQ(target.getEdges(static_cast<TypeParam>(i), static_cast<TypeParam>(j)),
+                      (i + j) % 3);
+        }
+    }
+    EXPECT_EQ(pattern.getVertexCount(), 1);
+}
+
+TYPED_TEST(GraphLoaderTest, ParallelParseReportsExactLineNumber) {
+    constexpr int n = 1100;
+    // Lines 1-2 hold the pattern, line 3 the target size, so row r is on line r + 4
+    this->createTestFile("1\n0\n" + largeMatrixText(n, 777));
+
+    try {
+        GraphLoader<TypeParam>::loadFromFile(this->testFilePath, 4);
+        FAIL() << "Expected std::runtime_error";
+    } catch (const std::runtime_error& e) {
+        const std::string message = e.what();
+        EXPECT_NE(message.find("Malformed second matrix row"), std::string::npos);
+        EXPECT_NE(message.find("(line 781)"), std::string::npos) << message;
+    }
+}
+
+TYPED_TEST(GraphLoaderTest, ParallelParseReportsTruncatedMatrix) {
+    constexpr int n = 1100;
+    std::string text = largeMatrixText(n, -1);
+    // Drop the last 100 rows: the file ends where row 1000 (line 1004) should start
+    for (int i = 0; i < 100; ++i) {
+        text.erase(text.rfind('\n', text.size() - 2) + 1);
+    }
+    this->createTestFile("1\n0\n" + text);
+
+    try {
+        GraphLoader<TypeParam>::loadFromFile(this->testFilePath, 4);
+        FAIL() << "Expected std::runtime_error";
+    } catch (const std::runtime_error& e) {
+        const std::string message = e.what();
+        EXPECT_NE(message.find("Unexpected end of file"), std::string::npos);
+        EXPECT_NE(message.find("(line 1004)"), std::string::npos) << message;
+    }
+}
+
+TYPED_TEST(GraphLoaderTest, ParallelParseStopsAtMatrixEnd) {
+    // Each matrix spans a few blocks, so with two threads the row count of the first one is
+    // reached in an early wave and the second one is parsed from where it ends
+    constexpr int n = 1100;
+    this->createTestFile(largeMatrixText(n, -1) + largeMatrixText(n - 1, -1));
+
+    auto [pattern, target] = GraphLoader<TypeParam>::loadFromFile(this->testFilePath, 2);
+
+    ASSERT_EQ(pattern.getVertexCount(), n - 1);
+    ASSERT_EQ(target.getVertexCount(), n);
+    for (int i = 0; i < n - 1; i += 37) {
+        for (int j = 0; j < n - 1; j += 13) {
+            ASSERT_EQ(pattern.getEdges(static_cast<TypeParam>(i), static_cast<TypeParam>(j)),
+                      (i + j) % 3);
+            ASSERT_EQ(target.getEdges(static_cast<TypeParam>(i), static_cast<TypeParam>(j)),
+                      (i + j) % 3);
+        }
+    }
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
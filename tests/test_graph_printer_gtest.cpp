@@ -0,0 +1,319 @@
+#include "algorithms/subgraph_algorithm.h"
+#include "graph/multigraph.h"
+#include "utils/graph_printer.h"
+#include "test_graphs.h"
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace Subgraphs;
+using SubgraphsTest::randomGraph;
+
+namespace {
+
+// Just enough JSON for the printer's output: objects, arrays, strings, numbers and booleans
+struct JsonValue {
+    enum class Kind { NUMBER, STRING, BOOLEAN, ARRAY, OBJECT } kind{Kind::NUMBER};
+    double number{};
+    bool boolean{};
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> fields; // In document order
+
+    const JsonValue* find(const std::string& key) const {
+        for (const auto& [name, value] : fields) {
+            if (name == key) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+  public:
+    explicit JsonParser(const std::string& text) : input(text) {}
+
+    // Parses one value that must span the whole text; fails the current test otherwise
+    JsonValue parseDocument() {
+        JsonValue value = parseValue();
+        EXPECT_EQ(position, input.size()) << "trailing characters in " << input;
+        return value;
+    }
+
+  private:
+    JsonValue parseValue() {
+        JsonValue value;
+        if (position >= input.size()) {
+            ADD_FAILURE() << "unexpected end of " << input;
+            return value;
+        }
+        const char c = input[position];
+        if (c == '{') {
+            value.kind = JsonValue::Kind::OBJECT;
+            ++position;
+            while (position < input.size() && input[position] != '}') {
+                std::string key = parseString();
+                expect(':');
+                value.fields.emplace_back(std::move(key), parseValue());
+                if (position < input.size() && input[position] == ',') {
+                    ++position;
+                }
+            }
+            expect('}');
+        } else if (c == '[') {
+            value.kind = JsonValue::Kind::ARRAY;
+            ++position;
+            while (position < input.size() && input[position] != ']') {
+                value.items.push_back(parseValue());
+                if (position < input.size() && input[position] == ',') {
+                    ++position;
+                }
+            }
+            expect(']');
+        } else if (c == '"') {
+            value.kind = JsonValue::Kind::STRING;
+            value.text = parseString();
+        } else if (input.compare(position, 4, "true") == 0) {
+            value.kind = JsonValue::Kind::BOOLEAN;
+            value.boolean = true;
+            position += 4;
+        } else if (input.compare(position, 5, "false") == 0) {
+            value.kind = JsonValue::Kind::BOOLEAN;
+            position += 5;
+        } else {
+            char* end = nullptr;
+            value.number = std::strtod(input.c_str() + position, &end);
+            const auto length = static_cast<size_t>(end - (input.c_str() + position));
+            EXPECT_GT(length, 0u) << "no value at " << position << " in " << input;
+            position += length == 0 ? 1 : length;
+        }
+        return value;
+    }
+
+    std::string parseString() {
+        std::string result;
+        expect('"');
+        while (position < input.size() && input[position] != '"') {
+            char c = input[position++];
+            if (c == '\\' && position < input.size()) {
+                c = input[position++];
+                c = c == 'n' ? '\n' : c == 't' ? '\t' : c == 'r' ? '\r' : c;
+            }
+            result += c;
+        }
+        expect('"');
+        return result;
+    }
+
+    void expect(char c) {
+        if (position < input.size() && input[position] == c) {
+            ++position;
+        } else {
+            ADD_FAILURE() << "expected '" << c << "' at " << position << " in " << input;
+            position = input.size();
+        }
+    }
+
+    const std::string& input;
+    size_t position{};
+};
+
+// "record,source,destination,value" rows split into their four columns
+std::vector<std::vector<std::string>> parseCsv(const std::string& table) {
+    std::vector<std::vector<std::string>> rows;
+    std::istringstream in(table);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::vector<std::string> columns;
+        std::istringstream fields(line);
+        std::string field;
+        while (std::getline(fields, field, ',')) {
+            columns.push_back(field);
+        }
+        if (!line.empty() && line.back() == ',') {
+            columns.emplace_back();
+        }
+        rows.push_back(std::move(columns));
+    }
+    return rows;
+}
+
+} // namespace
+
+class GraphPrinterTest : public ::testing::Test {
+  protected:
+    using Algorithm = SubgraphAlgorithm<int64_t>;
+
+    // An exact run on a small random pair, reported as main does
+    static RunReport<int64_t> exactReport() {
+        auto P = randomGraph<int64_t>(3, 2, 7);
+        auto G = randomGraph<int64_t>(5, 1, 8);
+        RunReport<int64_t> report;
+        report.file = "graphs/\"quoted\" \\ name.txt";
+        report.subgraphs = 2;
+        report.algorithm = AlgorithmType::EXACT;
+        ExactSearchStats stats;
+        report.extension = Algorithm::run_exact(2, P, G, ExactOptions{}, &stats, &report.timings);
+        report.exactStats = stats;
+        report.totalMs = 12.5;
+        return report;
+    }
+
+    static RunReport<int64_t> approx2Report() {
+        auto P = randomGraph<int64_t>(3, 2, 7);
+        auto G = randomGraph<int64_t>(5, 1, 8);
+        RunReport<int64_t> report;
+        report.file = "sample.txt";
+        report.subgraphs = 2;
+        report.algorithm = AlgorithmType::APPROX2;
+        report.heuristic = HeuristicType::DEGREE_DIFFERENCE;
+        report.extension = Algorithm::run_approx_v2(2, P, G, *report.heuristic, &report.timings);
+        report.totalMs = 3.0;
+        return report;
+    }
+
+    static uint64_t extensionSum(const RunReport<int64_t>& report) {
+        uint64_t sum = 0;
+        for (const auto& edge : report.extension) {
+            sum += edge.count;
+        }
+        return sum;
+    }
+
+    static std::string json(const RunReport<int64_t>& report) {
+        std::ostringstream out;
+        GraphPrinter<int64_t>::printJson(out, report);
+        return out.str();
+    }
+
+    static std::string csv(const RunReport<int64_t>& report) {
+        std::ostringstream out;
+        GraphPrinter<int64_t>::printCsv(out, report);
+        return out.str();
+    }
+
+    static void expectJsonExtension(const JsonValue& extension, const RunReport<int64_t>& report) {
+        ASSERT_EQ(extension.kind, JsonValue::Kind::ARRAY);
+        ASSERT_EQ(extension.items.size(), report.extension.size());
+        for (size_t i = 0; i < report.extension.size(); ++i) {
+            const auto& triple = extension.items[i].items;
+            ASSERT_EQ(triple.size(), 3u);
+            EXPECT_EQ(triple[0].number, static_cast<double>(report.extension[i].source));
+            EXPECT_EQ(triple[1].number, static_cast<double>(report.extension[i].destination));
+            EXPECT_EQ(triple[2].number, static_cast<double>(report.extension[i].count));
+        }
+    }
+};
+
+TEST_F(GraphPrinterTest, JsonForExactRun) {
+    const auto report = exactReport();
+    ASSERT_FALSE(report.extension.empty());
+    const std::string line = json(report);
+    ASSERT_EQ(line.find('\n'), line.size() - 1) << "expected a single line";
+
+    const std::string body = line.substr(0, line.size() - 1);
+    const JsonValue root = JsonParser(body).parseDocument();
+    ASSERT_EQ(root.kind, JsonValue::Kind::OBJECT);
+
+    std::vector<std::string> keys;
+    for (const auto& field : root.fields) {
+        keys.push_back(field.first);
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"file", "n", "algorithm", "cost", "optimal",
+                                              "lower_bound", "gap", "nodes", "initial_cost",
+                                              "extension", "timings_ms"}));
+
+    EXPECT_EQ(root.find("file")->text, report.file);
+    EXPECT_EQ(root.find("n")->number, 2.0);
+    EXPECT_EQ(root.find("algorithm")->text, "exact");
+    EXPECT_EQ(root.find("cost")->number, static_cast<double>(extensionSum(report)));
+    EXPECT_TRUE(root.find("optimal")->boolean);
+    EXPECT_EQ(root.find("lower_bound")->number, static_cast<double>(report.exactStats->lowerBound));
+    EXPECT_EQ(root.find("gap")->number, 0.0);
+    EXPECT_EQ(root.find("nodes")->number, static_cast<double>(report.exactStats->nodesExplored));
+    expectJsonExtension(*root.find("extension"), report);
+
+    const JsonValue* timings = root.find("timings_ms");
+    ASSERT_EQ(timings->kind, JsonValue::Kind::OBJECT);
+    for (const char* phase : {"load", "phase1", "phase2", "assignment", "merge", "total"}) {
+        ASSERT_NE(timings->find(phase), nullptr) << phase;
+        EXPECT_GE(timings->find(phase)->number, 0.0) << phase;
+    }
+    EXPECT_EQ(timings->find("total")->number, 12.5);
+}
+
+TEST_F(GraphPrinterTest, JsonForApprox2Run) {
+    const auto report = approx2Report();
+    const std::string line = json(report);
+    const JsonValue root = JsonParser(line.substr(0, line.size() - 1)).parseDocument();
+    ASSERT_EQ(root.kind, JsonValue::Kind::OBJECT);
+
+    EXPECT_EQ(root.find("algorithm")->text, "approx2");
+    ASSERT_NE(root.find("heuristic"), nullptr);
+    EXPECT_EQ(root.find("heuristic")->text, heuristicName(HeuristicType::DEGREE_DIFFERENCE));
+    EXPECT_EQ(root.find("cost")->number, static_cast<double>(extensionSum(report)));
+    expectJsonExtension(*root.find("extension"), report);
+    for (const char* exactOnly : {"optimal", "lower_bound", "gap", "nodes", "initial_cost"}) {
+        EXPECT_EQ(root.find(exactOnly), nullptr) << exactOnly;
+    }
+}
+
+TEST_F(GraphPrinterTest, CsvForExactRun) {
+    const auto report = exactReport();
+    const auto rows = parseCsv(csv(report));
+    ASSERT_EQ(rows.size(), 1 + report.extension.size() + 1 + 5 + 6);
+    EXPECT_EQ(rows[0], (std::vector<std::string>{"record", "source", "destination", "value"}));
+    for (const auto& row : rows) {
+        EXPECT_EQ(row.size(), 4u);
+    }
+
+    // One "edge" row per extension edge, in extension order
+    for (size_t i = 0; i < report.extension.size(); ++i) {
+        const auto& edge = report.extension[i];
+        EXPECT_EQ(rows[1 + i], (std::vector<std::string>{"edge", std::to_string(edge.source),
+                                                         std::to_string(edge.destination),
+                                                         std::to_string(edge.count)}));
+    }
+
+    // Then the summary rows, whose source and destination columns are empty
+    size_t row = 1 + report.extension.size();
+    EXPECT_EQ(rows[row], (std::vector<std::string>{"cost", "", "",
+                                                   std::to_string(extensionSum(report))}));
+    const std::vector<std::string> records = {"optimal",   "lower_bound",   "gap",
+                                              "nodes",     "initial_cost",  "load_ms",
+                                              "phase1_ms", "phase2_ms",     "assignment_ms",
+                                              "merge_ms",  "total_ms"};
+    for (const auto& record : records) {
+        ++row;
+        EXPECT_EQ(rows[row][0], record);
+        EXPECT_TRUE(rows[row][1].empty() && rows[row][2].empty()) << record;
+    }
+    EXPECT_EQ(rows[1 + report.extension.size() + 1][3], "true");
+    EXPECT_EQ(rows.back()[3], std::to_string(12.5));
+}
+
+TEST_F(GraphPrinterTest, CsvForApprox2Run) {
+    const auto report = approx2Report();
+    const auto rows = parseCsv(csv(report));
+    ASSERT_EQ(rows.size(), 1 + report.extension.size() + 1 + 6);
+
+    uint64_t edgeSum = 0;
+    for (size_t i = 1; i <= report.extension.size(); ++i) {
+        ASSERT_EQ(rows[i][0], "edge");
+        edgeSum += std::stoull(rows[i][3]);
+    }
+    const auto& cost = rows[1 + report.extension.size()];
+    EXPECT_EQ(cost[0], "cost");
+    EXPECT_EQ(std::stoull(cost[3]), edgeSum);
+    EXPECT_EQ(edgeSum, extensionSum(report));
+    EXPECT_EQ(rows[1 + report.extension.size() + 1][0], "load_ms");
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "graph/multigraph.h"
+
+namespace SubgraphsTest {
+
+// Random multigraph on `vertices` vertices (loops included) with 0 to maxEdges edges per
+// ordered pair. Fixed seeds keep the tests reproducible.
+template <typename IndexType>
+Subgraphs::Multigraph<IndexType> randomGraph(size_t vertices, uint8_t maxEdges, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> edges(0, maxEdges);
+    std::vector<std::vector<uint8_t>> matrix(vertices, std::vector<uint8_t>(vertices, 0));
+    for (auto& row : matrix) {
+        for (auto& cell : row) {
+            cell = static_cast<uint8_t>(edges(random));
+        }
+    }
+    return Subgraphs::Multigraph<IndexType>(std::move(matrix));
+}
+
+} // namespace SubgraphsTest
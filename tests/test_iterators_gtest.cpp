@@ -212,6 +212,22 @@ TYPED_TEST(CombinationIteratorTest, SpecificCombinations) {
     EXPECT_TRUE(uniqueCombs.count({2, 3, 4}) == 1);
 }
 
+TYPED_TEST(CombinationIteratorTest, StartsAtGivenCombination) {
+    std::vector<std::vector<TypeParam>> all;
+    for (const auto& comb : CombinationRange<TypeParam>(5, 3)) {
+        all.push_back(comb);
+    }
+
+    // Resuming from any combination yields exactly the remaining suffix
+    for (size_t first = 0; first < all.size(); ++first) {
+        std::vector<std::vector<TypeParam>> rest;
+        for (const auto& comb : CombinationRange<TypeParam>(5, 3, all[first])) {
+            rest.push_back(comb);
+        }
+        EXPECT_EQ(rest, std::vector<std::vector<TypeParam>>(all.begin() + first, all.end()));
+    }
+}
+
 // ============================================================================
 // Sequence Iterator Tests
 // ============================================================================
@@ -316,6 +332,21 @@ TYPED_TEST(SequenceIteratorTest, LargerSequence) {
     EXPECT_EQ(count, 27);
 }
 
+TYPED_TEST(SequenceIteratorTest, StartsAtGivenSequence) {
+    std::vector<std::vector<TypeParam>> all;
+    for (const auto& seq : SequenceRange<TypeParam>(3, 3)) {
+        all.push_back(seq);
+    }
+
+    for (size_t first = 0; first < all.size(); ++first) {
+        std::vector<std::vector<TypeParam>> rest;
+        for (const auto& seq : SequenceRange<TypeParam>(3, 3, all[first])) {
+            rest.push_back(seq);
+        }
+        EXPECT_EQ(rest, std::vector<std::vector<TypeParam>>(all.begin() + first, all.end()));
+    }
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,245 @@
+#include "algorithms/exact_planner.h"
+#include "algorithms/missing_edges.h"
+#include "algorithms/subgraph_algorithm.h"
+#include "graph/multigraph.h"
+#include "test_graphs.h"
+#include <filesystem>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace Subgraphs;
+using SubgraphsTest::randomGraph;
+
+namespace {
+
+template <typename IndexType>
+std::vector<Edge<IndexType>> toVector(std::span<const Edge<IndexType>> edges) {
+    return {edges.begin(), edges.end()};
+}
+
+} // namespace
+
+template <typename T> class MissingEdgesTest : public ::testing::Test {};
+
+using MissingEdgesTypes = ::testing::Types<int32_t, int64_t>;
+TYPED_TEST_SUITE(MissingEdgesTest, MissingEdgesTypes);
+
+TYPED_TEST(MissingEdgesTest, StreamingRowsMatchTheTable) {
+    auto P = randomGraph<TypeParam>(3, 2, 1);
+    auto G = randomGraph<TypeParam>(9, 2, 2);
+    const auto table = SubgraphAlgorithm<TypeParam>::getAllMissingEdges(P, G);
+    const auto numPerms = static_cast<TypeParam>(P.permutationsCount());
+    const auto numCombs = static_cast<TypeParam>(G.combinationsCount(P.getVertexCount()));
+
+    // Random order with two slots: most lookups evict a row
+    StreamingMissingEdges<TypeParam> streaming(P, G, 2);
+    std::mt19937 random(3);
+    std::uniform_int_distribution<int64_t> perm(0, numPerms - 1);
+    std::uniform_int_distribution<int64_t> comb(0, numCombs - 1);
+    for (int lookup = 0; lookup < 2000; ++lookup) {
+        const auto p = static_cast<TypeParam>(perm(random));
+        const auto c = static_cast<TypeParam>(comb(random));
+        ASSERT_EQ(toVector(streaming.edges(p, c)), table[p][c]) << "perm " << p << ", comb " << c;
+    }
+    EXPECT_EQ(streaming.capacity(), 2u);
+    EXPECT_GT(streaming.misses(), 1000u);
+}
+
+TYPED_TEST(MissingEdgesTest, StreamingCacheEvictsTheLeastRecentlyUsedRow) {
+    auto P = randomGraph<TypeParam>(3, 1, 4);
+    auto G = randomGraph<TypeParam>(6, 1, 5);
+    StreamingMissingEdges<TypeParam> streaming(P, G, 2);
+
+    streaming.edges(0, 0); // miss
+    streaming.edges(1, 1); // miss
+    streaming.edges(2, 0); // hit, so row 1 is now the oldest
+    streaming.edges(0, 2); // miss, evicts row 1
+    streaming.edges(3, 0); // hit
+    streaming.edges(4, 1); // miss
+    EXPECT_EQ(streaming.hits(), 2u);
+    EXPECT_EQ(streaming.misses(), 4u);
+}
+
+TYPED_TEST(MissingEdgesTest, LargeRowCacheMatchesAReferenceLru) {
+    // Thousands of rows, each holding one edge that names its subset, and a skewed request
+    // stream so that hits and evictions mix
+    constexpr size_t numCombs = 20000;
+    constexpr size_t capacity = 4000;
+    MissingEdgeRows<TypeParam> rows(numCombs, capacity);
+    auto fill = [](TypeParam combination, std::vector<uint32_t>& offsets,
+                   std::vector<Edge<TypeParam>>& edges) {
+        offsets = {0, 1};
+        edges.emplace_back(combination, combination, 1);
+    };
+
+    std::list<size_t> recency; // Most recent first
+    std::unordered_map<size_t, std::list<size_t>::iterator> cached;
+    uint64_t hits = 0;
+    std::mt19937 random(9);
+    std::geometric_distribution<size_t> skew(1.0 / 3000);
+    for (int request = 0; request < 200000; ++request) {
+        const size_t combination = skew(random) % numCombs;
+        auto found = cached.find(combination);
+        if (found != cached.end()) {
+            ++hits;
+            recency.erase(found->second);
+        } else if (cached.size() == capacity) {
+            cached.erase(recency.back());
+            recency.pop_back();
+        }
+        recency.push_front(combination);
+        cached[combination] = recency.begin();
+
+        const auto edges = rows.edges(0, static_cast<TypeParam>(combination), fill);
+        ASSERT_EQ(edges.size(), 1u);
+        ASSERT_EQ(static_cast<size_t>(edges[0].source), combination);
+    }
+    EXPECT_EQ(rows.hits(), hits);
+    EXPECT_EQ(rows.misses(), 200000u - hits);
+    EXPECT_GT(hits, 0u);
+    EXPECT_GT(rows.misses(), capacity);
+}
+
+TYPED_TEST(MissingEdgesTest, StreamingSearchMatchesTheTableSearch) {
+    for (int copies = 1; copies <= 3; ++copies) {
+        auto P = randomGraph<TypeParam>(3, 2, 10 + static_cast<uint32_t>(copies));
+        auto G = randomGraph<TypeParam>(7, 1, 20 + static_cast<uint32_t>(copies));
+
+        ExactOptions options;
+        options.warmStart = copies == 2 ? std::optional(AlgorithmType::APPROX1) : std::nullopt;
+        ExactSearchStats tableStats;
+        const auto expected =
+            SubgraphAlgorithm<TypeParam>::run_exact(copies, P, G, options, &tableStats);
+
+        // One byte of cache still keeps one row per copy
+        options.storage = MissingEdgeStorage::STREAMING;
+        options.streamingCacheBytes = 1;
+        ExactSearchStats streamingStats;
+        const auto result =
+            SubgraphAlgorithm<TypeParam>::run_exact(copies, P, G, options, &streamingStats);
+
+        EXPECT_EQ(result, expected) << copies << " copies";
+        EXPECT_EQ(streamingStats.cost, tableStats.cost);
+        EXPECT_EQ(streamingStats.nodesExplored, tableStats.nodesExplored);
+        EXPECT_TRUE(streamingStats.optimal);
+    }
+}
+
+TYPED_TEST(MissingEdgesTest, SpilledRowsMatchTheTable) {
+    auto P = randomGraph<TypeParam>(3, 2, 6);
+    auto G = randomGraph<TypeParam>(9, 2, 7);
+    const auto table = SubgraphAlgorithm<TypeParam>::getAllMissingEdges(P, G);
+    const auto path = std::filesystem::temp_directory_path() / "test_missing_edges_spill.bin";
+    {
+        SpilledMissingEdges<TypeParam> spilled(P, G, path);
+        ASSERT_TRUE(std::filesystem::exists(path));
+        EXPECT_EQ(spilled.fileBytes(), std::filesystem::file_size(path));
+        for (size_t p = 0; p < table.size(); ++p) {
+            for (size_t c = 0; c < table[p].size(); ++c) {
+                ASSERT_EQ(toVector(spilled.edges(static_cast<TypeParam>(p),
+                                                 static_cast<TypeParam>(c))),
+                          table[p][c])
+                    << "perm " << p << ", comb " << c;
+            }
+        }
+
+        // Per subset, only the padding of its edges is not estimated
+        const ExactPlan plan = planExact(1, P, G);
+        const uint64_t combinations = table.empty() ? 0 : table[0].size();
+        EXPECT_LE(plan.spillFileBytes, spilled.fileBytes());
+        EXPECT_LE(spilled.fileBytes(), plan.spillFileBytes + 8 * combinations);
+    }
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TYPED_TEST(MissingEdgesTest, SpilledSearchMatchesTheTableSearch) {
+    for (int copies = 1; copies <= 3; ++copies) {
+        auto P = randomGraph<TypeParam>(3, 2, 30 + static_cast<uint32_t>(copies));
+        auto G = randomGraph<TypeParam>(7, 1, 40 + static_cast<uint32_t>(copies));
+
+        ExactOptions options;
+        ExactSearchStats tableStats;
+        const auto expected =
+            SubgraphAlgorithm<TypeParam>::run_exact(copies, P, G, options, &tableStats);
+
+        options.storage = MissingEdgeStorage::SPILLED;
+        options.spillDirectory = std::filesystem::temp_directory_path();
+        ExactSearchStats spilledStats;
+        const auto result =
+            SubgraphAlgorithm<TypeParam>::run_exact(copies, P, G, options, &spilledStats);
+
+        EXPECT_EQ(result, expected) << copies << " copies";
+        EXPECT_EQ(spilledStats.cost, tableStats.cost);
+        EXPECT_EQ(spilledStats.nodesExplored, tableStats.nodesExplored);
+        EXPECT_TRUE(spilledStats.optimal);
+    }
+}
+
+TEST(MissingEdgesTest, SpillingRequiresADirectory) {
+    auto P = randomGraph<int32_t>(3, 1, 50);
+    auto G = randomGraph<int32_t>(6, 1, 51);
+    ExactOptions options;
+    options.storage = MissingEdgeStorage::SPILLED;
+    EXPECT_THROW(SubgraphAlgorithm<int32_t>::run_exact(1, P, G, options), std::invalid_argument);
+}
+
+TYPED_TEST(MissingEdgesTest, CompactRowsMatchTheTable) {
+    // Deficits above 4 make some subsets store pairs and deficits apart
+    for (uint8_t maxEdges : {uint8_t{3}, uint8_t{20}}) {
+        auto P = randomGraph<TypeParam>(4, maxEdges, 60 + maxEdges);
+        auto G = randomGraph<TypeParam>(8, maxEdges, 70 + maxEdges);
+        const auto table = SubgraphAlgorithm<TypeParam>::getAllMissingEdges(P, G);
+        CompactMissingEdges<TypeParam> compact(P, G, 2);
+        for (size_t p = 0; p < table.size(); ++p) {
+            for (size_t c = 0; c < table[p].size(); ++c) {
+                ASSERT_EQ(toVector(compact.edges(static_cast<TypeParam>(p),
+                                                 static_cast<TypeParam>(c))),
+                          table[p][c])
+                    << "perm " << p << ", comb " << c;
+            }
+        }
+
+        // The planner bounds the encoding from above
+        const ExactPlan plan = planExact(1, P, G);
+        EXPECT_LE(compact.bytes(), plan.compactBytes) << "max edges " << int{maxEdges};
+    }
+}
+
+TEST(MissingEdgesTest, CompactTableIsAFractionOfTheTable) {
+    auto P = randomGraph<int64_t>(5, 2, 80);
+    auto G = randomGraph<int64_t>(10, 2, 81);
+    const ExactPlan plan = planExact(1, P, G);
+    const CompactMissingEdges<int64_t> compact(P, G, 1);
+    EXPECT_LT(compact.bytes() * 8, plan.phase1Bytes);
+}
+
+TYPED_TEST(MissingEdgesTest, CompactSearchMatchesTheTableSearch) {
+    for (int copies = 1; copies <= 3; ++copies) {
+        auto P = randomGraph<TypeParam>(3, 2, 90 + static_cast<uint32_t>(copies));
+        auto G = randomGraph<TypeParam>(7, 1, 100 + static_cast<uint32_t>(copies));
+
+        ExactOptions options;
+        options.warmStart = copies == 2 ? std::optional(AlgorithmType::APPROX1) : std::nullopt;
+        ExactSearchStats tableStats;
+        const auto expected =
+            SubgraphAlgorithm<TypeParam>::run_exact(copies, P, G, options, &tableStats);
+
+        options.storage = MissingEdgeStorage::COMPACT;
+        ExactSearchStats compactStats;
+        const auto result =
+            SubgraphAlgorithm<TypeParam>::run_exact(copies, P, G, options, &compactStats);
+
+        EXPECT_EQ(result, expected) << copies << " copies";
+        EXPECT_EQ(compactStats.cost, tableStats.cost);
+        EXPECT_EQ(compactStats.nodesExplored, tableStats.nodesExplored);
+        EXPECT_TRUE(compactStats.optimal);
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
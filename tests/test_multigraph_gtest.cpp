@@ -28,6 +28,19 @@ TYPED_TEST(MultigraphTest, ConstructorWithMatrix) {
     EXPECT_EQ(graph.getEdgeCount(), 4);
 }
 
+TYPED_TEST(MultigraphTest, ConstructorWithFlatMatrix) {
+    std::vector<uint8_t> matrix = {0, 1, 0, 2, 0, 1, 0, 0, 3};
+    Multigraph<TypeParam> graph(3, std::move(matrix));
+    EXPECT_EQ(graph.getVertexCount(), 3);
+    EXPECT_EQ(graph.getEdgeCount(), 7);
+    EXPECT_EQ(graph.getEdges(1, 0), 2);
+    EXPECT_EQ(graph.getEdges(2, 2), 3);
+
+    auto nested = graph.getAdjacencyMatrix();
+    ASSERT_EQ(nested.size(), 3u);
+    EXPECT_EQ(nested[1], (std::vector<uint8_t>{2, 0, 1}));
+}
+
 TYPED_TEST(MultigraphTest, AddEdges) {
     Multigraph<TypeParam> graph(3);
     graph.addEdges(0, 1, 2);
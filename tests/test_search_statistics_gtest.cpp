@@ -0,0 +1,104 @@
+// Statistics are compiled in for this test regardless of the SUBGRAPHS_STATS option
+#undef SUBGRAPHS_STATS
+#define SUBGRAPHS_STATS 1
+
+#include "algorithms/subgraph_algorithm.h"
+#include "graph/multigraph.h"
+#include "utils/search_statistics.h"
+#include <sstream>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace Subgraphs;
+
+template <typename T> class SearchStatisticsTest : public ::testing::Test {
+  protected:
+    static Multigraph<T> pattern() {
+        return Multigraph<T>(std::vector<std::vector<uint8_t>>{
+            {0, 2, 1, 0}, {1, 0, 0, 1}, {0, 1, 0, 2}, {1, 0, 1, 0}});
+    }
+
+    static Multigraph<T> target() {
+        std::vector<std::vector<uint8_t>> matrix(6, std::vector<uint8_t>(6, 0));
+        for (size_t i = 0; i < 6; ++i) {
+            for (size_t j = 0; j < 6; ++j) {
+                if (i != j) {
+                    matrix[i][j] = static_cast<uint8_t>((i * 5 + j * 3) % 3 == 0);
+                }
+            }
+        }
+        return Multigraph<T>(std::move(matrix));
+    }
+};
+
+using StatisticsTypes = ::testing::Types<int32_t, int64_t>;
+TYPED_TEST_SUITE(SearchStatisticsTest, StatisticsTypes);
+
+TEST(SearchStatisticsTest, EnabledInThisTest) {
+    EXPECT_TRUE(SEARCH_STATISTICS_ENABLED);
+}
+
+TYPED_TEST(SearchStatisticsTest, ExactSearchFillsCounters) {
+    auto P = this->pattern();
+    auto G = this->target();
+
+    SearchStatistics statistics;
+    ExactOptions options;
+    options.statistics = &statistics;
+    ExactSearchStats stats;
+    SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, options, &stats);
+
+    // Phase 1: 4! permutations × C(6, 4) subsets
+    EXPECT_EQ(statistics.embeddingsComputed, 24u * 15u);
+    EXPECT_GT(statistics.phase1TableBytes, 0u);
+
+    // Every node is either a combination set or a permutation sequence
+    EXPECT_EQ(statistics.combinationSetsVisited + statistics.configurationsVisited,
+              stats.nodesExplored);
+    EXPECT_LE(statistics.combinationSetsPruned, statistics.combinationSetsVisited);
+    EXPECT_LE(statistics.configurationsPrunedEarly, statistics.configurationsVisited);
+    EXPECT_GE(statistics.embeddingsMerged, statistics.configurationsVisited);
+
+    // The incumbent only improves, starting at the initial one and ending at the result
+    ASSERT_FALSE(statistics.improvements.empty());
+    EXPECT_EQ(statistics.improvements.front().cost, stats.initialCost);
+    EXPECT_EQ(statistics.improvements.back().cost, stats.cost);
+    for (size_t i = 1; i < statistics.improvements.size(); ++i) {
+        EXPECT_LT(statistics.improvements[i].cost, statistics.improvements[i - 1].cost);
+        EXPECT_GE(statistics.improvements[i].nodesExplored,
+                  statistics.improvements[i - 1].nodesExplored);
+    }
+
+    std::ostringstream summary;
+    statistics.print(summary);
+    EXPECT_NE(summary.str().find("Configurations visited"), std::string::npos);
+}
+
+TYPED_TEST(SearchStatisticsTest, ResultUnchangedByStatistics) {
+    auto P = this->pattern();
+    auto G = this->target();
+
+    SearchStatistics statistics;
+    ExactOptions options;
+    options.statistics = &statistics;
+    auto withStatistics = SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, options);
+    auto without = SubgraphAlgorithm<TypeParam>::run(2, P, G);
+    EXPECT_EQ(SubgraphAlgorithm<TypeParam>::extensionCost(withStatistics),
+              SubgraphAlgorithm<TypeParam>::extensionCost(without));
+}
+
+TEST(SearchStatisticsTest, DisabledRecorderIsEmpty) {
+    // The disabled recorder has no state, so recording compiles to nothing
+    EXPECT_TRUE(std::is_empty_v<StatisticsRecorder<false>>);
+    SearchStatistics statistics;
+    StatisticsRecorder<false> recorder(&statistics);
+    recorder.configurationVisited();
+    recorder.flush();
+    EXPECT_EQ(statistics.configurationsVisited, 0u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
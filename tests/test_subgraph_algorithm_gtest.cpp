@@ -1,16 +1,33 @@
 #include "algorithms/subgraph_algorithm.h"
 #include "graph/multigraph.h"
+#include "utils/shard_result.h"
+#include "test_graphs.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <limits>
+#include <set>
 #include <vector>
 #include <gtest/gtest.h>
 
 using namespace Subgraphs;
+using SubgraphsTest::randomGraph;
 
 template <typename T> class SubgraphAlgorithmTest : public ::testing::Test {
   protected:
-    void SetUp() override {
+    // A small pair with hand-picked multiplicities: P on 3 vertices, G on 5
+    static Multigraph<T> smallPattern() {
+        return Multigraph<T>(std::vector<std::vector<uint8_t>>{{0, 2, 1}, {1, 0, 0}, {0, 1, 0}});
     }
-    void TearDown() override {
+    static Multigraph<T> smallTarget() {
+        return Multigraph<T>(std::vector<std::vector<uint8_t>>{
+            {0, 1, 0, 0, 1}, {0, 0, 2, 0, 0}, {1, 0, 0, 1, 0}, {0, 0, 0, 0, 3}, {2, 0, 1, 0, 0}});
     }
+
+    // A pair whose exact search explores about 13k nodes for n = 2 and 1.4M for n = 3, so
+    // deadlines, stop requests and checkpoints (checked every 1024 nodes) are reached
+    static Multigraph<T> searchPattern() { return randomGraph<T>(3, 2, 1); }
+    static Multigraph<T> searchTarget() { return randomGraph<T>(7, 1, 101); }
 };
 
 using AlgorithmTypes = ::testing::Types<int32_t, int64_t>;
@@ -127,6 +144,391 @@ TYPED_TEST(SubgraphAlgorithmTest, EdgeStructure) {
     }
 }
 
+TYPED_TEST(SubgraphAlgorithmTest, ApproxV1IsDeterministic) {
+    // 4 × 20 seeds, enough for Phase 1 to use a pool
+    auto P = randomGraph<TypeParam>(4, 2, 3);
+    auto G = randomGraph<TypeParam>(20, 3, 4);
+
+    // The selected extension must not depend on the thread count or on scheduling
+    auto first = SubgraphAlgorithm<TypeParam>::run_approx_v1(3, P, G, nullptr, 1);
+    for (int run = 0; run < 5; ++run) {
+        auto again = SubgraphAlgorithm<TypeParam>::run_approx_v1(3, P, G, nullptr, 4);
+        ASSERT_EQ(again.size(), first.size());
+        for (size_t i = 0; i < first.size(); ++i) {
+            EXPECT_EQ(again[i], first[i]);
+        }
+    }
+}
+
+// approx1 written out directly: each seed (u1, u2) greedily adds the cheapest unmapped pair
+// (first in (v1, v2) order), with the cost summed from scratch over the mapped vertices; the
+// configurations are sorted by (cost, seed index) and a std::set keeps the first n distinct
+// vertex sets
+template <typename T>
+std::vector<Edge<T>> referenceApproxV1(int n, const Multigraph<T>& P, const Multigraph<T>& G) {
+    const T k = P.getVertexCount();
+    const T numG = G.getVertexCount();
+    auto missing = [](uint8_t pEdges, uint8_t gEdges) {
+        return pEdges > gEdges ? static_cast<T>(pEdges - gEdges) : T{0};
+    };
+
+    struct Configuration {
+        T cost{};
+        size_t seed{};
+        std::vector<T> mapping;
+    };
+    std::vector<Configuration> configurations;
+    for (T u1 = 0; u1 < k; ++u1) {
+        for (T u2 = 0; u2 < numG; ++u2) {
+            std::vector<T> mapping(static_cast<size_t>(k), -1);
+            std::vector<bool> usedG(static_cast<size_t>(numG), false);
+            mapping[u1] = u2;
+            usedG[u2] = true;
+            for (T step = 1; step < k; ++step) {
+                T bestV1 = -1, bestV2 = -1;
+                T bestCost = std::numeric_limits<T>::max();
+                for (T v1 = 0; v1 < k; ++v1) {
+                    if (mapping[v1] != -1) continue;
+                    for (T v2 = 0; v2 < numG; ++v2) {
+                        if (usedG[v2]) continue;
+                        T cost = 0;
+                        for (T u = 0; u < k; ++u) {
+                            if (mapping[u] == -1) continue;
+                            cost += missing(P.getEdges(u, v1), G.getEdges(mapping[u], v2));
+                            cost += missing(P.getEdges(v1, u), G.getEdges(v2, mapping[u]));
+                        }
+                        if (cost < bestCost) {
+                            bestCost = cost;
+                            bestV1 = v1;
+                            bestV2 = v2;
+                        }
+                    }
+                }
+                mapping[bestV1] = bestV2;
+                usedG[bestV2] = true;
+            }
+
+            Configuration configuration;
+            configuration.seed = static_cast<size_t>(u1) * static_cast<size_t>(numG) +
+                                 static_cast<size_t>(u2);
+            for (T i = 0; i < k; ++i) {
+                for (T j = 0; j < k; ++j) {
+                    configuration.cost +=
+                        missing(P.getEdges(i, j), G.getEdges(mapping[i], mapping[j]));
+                }
+            }
+            configuration.mapping = std::move(mapping);
+            configurations.push_back(std::move(configuration));
+        }
+    }
+    std::sort(configurations.begin(), configurations.end(),
+              [](const Configuration& a, const Configuration& b) {
+                  return a.cost != b.cost ? a.cost < b.cost : a.seed < b.seed;
+              });
+
+    std::set<std::vector<T>> usedSets;
+    std::vector<std::vector<uint8_t>> merged(static_cast<size_t>(numG),
+                                             std::vector<uint8_t>(static_cast<size_t>(numG), 0));
+    for (const auto& configuration : configurations) {
+        if (usedSets.size() == static_cast<size_t>(n)) break;
+        std::vector<T> vertexSet = configuration.mapping;
+        std::sort(vertexSet.begin(), vertexSet.end());
+        if (!usedSets.insert(vertexSet).second) continue;
+        for (T i = 0; i < k; ++i) {
+            for (T j = 0; j < k; ++j) {
+                const T gi = configuration.mapping[i];
+                const T gj = configuration.mapping[j];
+                const auto count =
+                    static_cast<uint8_t>(missing(P.getEdges(i, j), G.getEdges(gi, gj)));
+                merged[gi][gj] = std::max(merged[gi][gj], count);
+            }
+        }
+    }
+
+    std::vector<Edge<T>> result;
+    for (T i = 0; i < numG; ++i) {
+        for (T j = 0; j < numG; ++j) {
+            if (merged[i][j] > 0) {
+                result.emplace_back(i, j, merged[i][j]);
+            }
+        }
+    }
+    return result;
+}
+
+TYPED_TEST(SubgraphAlgorithmTest, ApproxV1MatchesReferenceSelection) {
+    // Few edge multiplicities give many equal costs, so the (cost, seed index) tie-break
+    // decides which configurations are kept; small G repeats vertex sets across seeds, and n
+    // up to |V_G| + 2 also asks for more distinct sets than exist
+    for (uint32_t seed = 0; seed < 40; ++seed) {
+        const size_t patternSize = 2 + seed % 3;
+        const size_t targetSize = patternSize + seed % 7;
+        auto P = randomGraph<TypeParam>(patternSize, 2, seed);
+        const auto maxEdges = static_cast<uint8_t>(1 + seed % 2);
+        auto G = randomGraph<TypeParam>(targetSize, maxEdges, seed + 1000);
+        for (int n : {1, 2, static_cast<int>(targetSize), static_cast<int>(targetSize) + 2}) {
+            SCOPED_TRACE("seed " + std::to_string(seed) + ", n = " + std::to_string(n));
+            auto expected = referenceApproxV1(n, P, G);
+            for (size_t threads : {size_t{1}, size_t{4}}) {
+                auto result =
+                    SubgraphAlgorithm<TypeParam>::run_approx_v1(n, P, G, nullptr, threads);
+                ASSERT_EQ(result.size(), expected.size());
+                for (size_t i = 0; i < expected.size(); ++i) {
+                    EXPECT_EQ(result[i], expected[i]);
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(SubgraphAlgorithmTest, PortfolioReturnsCheapestMember) {
+    auto P = this->smallPattern();
+    auto G = this->smallTarget();
+
+    std::vector<PortfolioEntry<TypeParam>> members;
+    auto result = SubgraphAlgorithm<TypeParam>::run_portfolio(2, P, G, &members);
+
+    // approx1 plus one member per approx2 heuristic
+    ASSERT_EQ(members.size(), ALL_HEURISTICS.size() + 1);
+    EXPECT_EQ(members[0].name, "approx1");
+    EXPECT_EQ(members[1].name, "approx2_degree");
+
+    uint64_t cheapest = members[0].cost;
+    for (const auto& member : members) {
+        EXPECT_EQ(member.cost, SubgraphAlgorithm<TypeParam>::extensionCost(member.extension));
+        EXPECT_GE(member.milliseconds, 0.0);
+        cheapest = std::min(cheapest, member.cost);
+    }
+    EXPECT_EQ(SubgraphAlgorithm<TypeParam>::extensionCost(result), cheapest);
+
+    // Members must match standalone runs of the same algorithms
+    EXPECT_EQ(members[0].cost, SubgraphAlgorithm<TypeParam>::extensionCost(
+                                   SubgraphAlgorithm<TypeParam>::run_approx_v1(2, P, G)));
+    for (size_t i = 0; i < ALL_HEURISTICS.size(); ++i) {
+        auto standalone = SubgraphAlgorithm<TypeParam>::run_approx_v2(2, P, G, ALL_HEURISTICS[i]);
+        EXPECT_EQ(members[i + 1].cost, SubgraphAlgorithm<TypeParam>::extensionCost(standalone));
+    }
+
+    // One thread runs the members in turn and gives the same members and result
+    std::vector<PortfolioEntry<TypeParam>> serialMembers;
+    auto serial = SubgraphAlgorithm<TypeParam>::run_portfolio(2, P, G, &serialMembers, 1);
+    ASSERT_EQ(serialMembers.size(), members.size());
+    for (size_t i = 0; i < members.size(); ++i) {
+        EXPECT_EQ(serialMembers[i].name, members[i].name);
+        EXPECT_EQ(serialMembers[i].cost, members[i].cost);
+    }
+    EXPECT_EQ(serial, result);
+}
+
+TYPED_TEST(SubgraphAlgorithmTest, PhaseTimingsLeaveResultUnchanged) {
+    auto P = this->smallPattern();
+    auto G = this->smallTarget();
+
+    for (AlgorithmType algorithm : {AlgorithmType::EXACT, AlgorithmType::APPROX1,
+                                    AlgorithmType::APPROX2}) {
+        PhaseTimings timings;
+        auto timed = SubgraphAlgorithm<TypeParam>::run_algorithm(
+            algorithm, 2, P, G, HeuristicType::DEGREE_DIFFERENCE, &timings);
+        auto untimed = SubgraphAlgorithm<TypeParam>::run_algorithm(algorithm, 2, P, G);
+        EXPECT_EQ(SubgraphAlgorithm<TypeParam>::extensionCost(timed),
+                  SubgraphAlgorithm<TypeParam>::extensionCost(untimed));
+
+        EXPECT_EQ(timings.loadMs, 0.0);
+        EXPECT_GE(timings.phase1Ms, 0.0);
+        EXPECT_GE(timings.phase2Ms, 0.0);
+        EXPECT_GE(timings.assignmentMs, 0.0);
+        EXPECT_GE(timings.mergeMs, 0.0);
+        if (algorithm == AlgorithmType::EXACT) {
+            // The exact algorithm has no assignment or merge phase
+            EXPECT_EQ(timings.assignmentMs, 0.0);
+            EXPECT_EQ(timings.mergeMs, 0.0);
+        }
+    }
+}
+
+TYPED_TEST(SubgraphAlgorithmTest, ExactReportsBounds) {
+    auto P = this->smallPattern();
+    auto G = this->smallTarget();
+
+    ExactSearchStats stats;
+    auto result = SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, ExactOptions{}, &stats);
+    EXPECT_TRUE(stats.optimal);
+    EXPECT_EQ(stats.cost, SubgraphAlgorithm<TypeParam>::extensionCost(result));
+    EXPECT_EQ(stats.lowerBound, stats.cost);
+    EXPECT_EQ(stats.gap(), 0.0);
+    EXPECT_EQ(stats.cost,
+              SubgraphAlgorithm<TypeParam>::extensionCost(SubgraphAlgorithm<TypeParam>::run(2, P, G)));
+}
+
+TYPED_TEST(SubgraphAlgorithmTest, WarmStartKeepsOptimalCost) {
+    auto P = this->smallPattern();
+    auto G = this->smallTarget();
+
+    const uint64_t optimum =
+        SubgraphAlgorithm<TypeParam>::extensionCost(SubgraphAlgorithm<TypeParam>::run(2, P, G));
+    for (AlgorithmType warmStart :
+         {AlgorithmType::APPROX1, AlgorithmType::APPROX2, AlgorithmType::PORTFOLIO}) {
+        ExactOptions options;
+        options.warmStart = warmStart;
+        ExactSearchStats stats;
+        auto result = SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, options, &stats);
+        EXPECT_TRUE(stats.optimal);
+        EXPECT_EQ(SubgraphAlgorithm<TypeParam>::extensionCost(result), optimum);
+        EXPECT_GE(stats.initialCost, optimum);
+    }
+}
+
+TYPED_TEST(SubgraphAlgorithmTest, ExactTimeLimitReturnsValidIncumbent) {
+    auto P = this->searchPattern();
+    auto G = this->searchTarget();
+
+    // The deadline has passed by the first check, so the search stops almost immediately
+    // instead of exploring its 1.4M nodes
+    ExactOptions options;
+    options.timeLimitSeconds = 1e-9;
+    ExactSearchStats stats;
+    auto incumbent = SubgraphAlgorithm<TypeParam>::run_exact(3, P, G, options, &stats);
+
+    EXPECT_FALSE(stats.optimal);
+    EXPECT_LT(stats.nodesExplored, 1u << 20);
+    EXPECT_EQ(stats.cost, SubgraphAlgorithm<TypeParam>::extensionCost(incumbent));
+    EXPECT_LE(stats.lowerBound, stats.cost);
+    EXPECT_GE(stats.gap(), 0.0);
+    EXPECT_LE(stats.gap(), 1.0);
+}
+
+TYPED_TEST(SubgraphAlgorithmTest, ExactHugeTimeLimitIsNoLimit) {
+    auto P = this->searchPattern();
+    auto G = this->searchTarget();
+    ExactSearchStats unlimited;
+    SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, ExactOptions{}, &unlimited);
+    // Enough nodes for the deadline to be checked
+    ASSERT_GT(unlimited.nodesExplored, 1024u);
+
+    // Limits the clock cannot represent used to overflow into a deadline in the past
+    for (double limit : {1e300, std::numeric_limits<double>::infinity()}) {
+        ExactOptions options;
+        options.timeLimitSeconds = limit;
+        ExactSearchStats stats;
+        auto extension = SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, options, &stats);
+        EXPECT_TRUE(stats.optimal) << limit;
+        EXPECT_EQ(stats.cost, unlimited.cost) << limit;
+        EXPECT_EQ(stats.nodesExplored, unlimited.nodesExplored) << limit;
+        EXPECT_EQ(SubgraphAlgorithm<TypeParam>::extensionCost(extension), unlimited.cost);
+    }
+}
+
+TYPED_TEST(SubgraphAlgorithmTest, ExactResumesFromCheckpoint) {
+    auto P = this->searchPattern();
+    auto G = this->searchTarget();
+
+    const auto checkpointPath = std::filesystem::temp_directory_path() /
+                                ("subgraphs_checkpoint_" + std::to_string(sizeof(TypeParam)));
+    std::filesystem::remove(checkpointPath);
+
+    ExactSearchStats full;
+    auto expected = SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, ExactOptions{}, &full);
+    ASSERT_TRUE(full.optimal);
+
+    // Stop immediately; the frontier is written when the search stops
+    std::atomic<bool> stop{true};
+    ExactOptions options;
+    options.checkpointPath = checkpointPath;
+    options.stopRequested = &stop;
+    ExactSearchStats interrupted;
+    SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, options, &interrupted);
+    ASSERT_FALSE(interrupted.optimal);
+    ASSERT_TRUE(std::filesystem::exists(checkpointPath));
+
+    const auto vertexCount = static_cast<uint64_t>(G.getVertexCount());
+    auto checkpoint = ExactCheckpoint<TypeParam>::load(checkpointPath, vertexCount);
+    ASSERT_TRUE(checkpoint.has_value());
+    EXPECT_EQ(checkpoint->cost, interrupted.cost);
+    EXPECT_EQ(checkpoint->combination.size(), 2u);
+    ASSERT_FALSE(checkpoint->extension.empty());
+
+    // An incumbent edge naming a vertex outside G makes the checkpoint malformed
+    auto corrupt = *checkpoint;
+    corrupt.extension.front().destination = static_cast<TypeParam>(vertexCount);
+    const auto corruptPath = checkpointPath.string() + ".corrupt";
+    corrupt.save(corruptPath);
+    EXPECT_THROW(ExactCheckpoint<TypeParam>::load(corruptPath, vertexCount), std::runtime_error);
+    EXPECT_TRUE(ExactCheckpoint<TypeParam>::load(corruptPath, vertexCount + 1).has_value());
+    std::filesystem::remove(corruptPath);
+
+    // Resuming finishes the search with the same optimum and removes the checkpoint
+    stop = false;
+    options.resume = true;
+    ExactSearchStats resumed;
+    auto result = SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, options, &resumed);
+    EXPECT_TRUE(resumed.optimal);
+    EXPECT_EQ(SubgraphAlgorithm<TypeParam>::extensionCost(result),
+              SubgraphAlgorithm<TypeParam>::extensionCost(expected));
+    EXPECT_GE(resumed.nodesExplored, interrupted.nodesExplored);
+    EXPECT_FALSE(std::filesystem::exists(checkpointPath));
+}
+
+TYPED_TEST(SubgraphAlgorithmTest, ShardsMergeToGlobalOptimum) {
+    auto P = this->searchPattern();
+    auto G = this->searchTarget();
+
+    ExactSearchStats full;
+    auto expected = SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, ExactOptions{}, &full);
+    ASSERT_TRUE(full.optimal);
+
+    const auto resultPath = std::filesystem::temp_directory_path() /
+                            ("subgraphs_shard_" + std::to_string(sizeof(TypeParam)));
+    std::vector<ShardResult<TypeParam>> shards;
+    for (uint64_t shard = 0; shard < 3; ++shard) {
+        ExactOptions options;
+        options.shardIndex = shard;
+        options.shardCount = 3;
+        ExactSearchStats stats;
+        auto extension = SubgraphAlgorithm<TypeParam>::run_exact(2, P, G, options, &stats);
+        EXPECT_TRUE(stats.optimal);
+        EXPECT_EQ(stats.fingerprint, full.fingerprint);
+
+        // Round trip through the result file, as the CLI does between processes
+        ShardResult<TypeParam>::fromSearch(2, static_cast<uint64_t>(G.getVertexCount()), options,
+                                           stats, std::move(extension))
+            .save(resultPath);
+        shards.push_back(ShardResult<TypeParam>::load(resultPath));
+    }
+
+    // A result with an edge outside 0..|V_G|-1 is rejected when it is read back
+    auto corrupt = shards.front();
+    ASSERT_FALSE(corrupt.extension.empty());
+    corrupt.extension.back().source = static_cast<TypeParam>(corrupt.vertexCount);
+    corrupt.save(resultPath);
+    EXPECT_THROW(ShardResult<TypeParam>::load(resultPath), std::runtime_error);
+    std::filesystem::remove(resultPath);
+
+    // The file order does not matter
+    std::swap(shards.front(), shards.back());
+    auto merged = ShardResult<TypeParam>::merge(shards);
+    EXPECT_TRUE(merged.optimal);
+    EXPECT_EQ(merged.cost, full.cost);
+    EXPECT_EQ(merged.lowerBound, full.cost);
+    EXPECT_EQ(SubgraphAlgorithm<TypeParam>::extensionCost(merged.extension),
+              SubgraphAlgorithm<TypeParam>::extensionCost(expected));
+    EXPECT_EQ(merged.vertexCount, static_cast<uint64_t>(G.getVertexCount()));
+
+    auto resized = shards;
+    resized.front().vertexCount += 1;
+    EXPECT_THROW(ShardResult<TypeParam>::merge(resized), std::invalid_argument);
+
+    shards.pop_back();
+    EXPECT_THROW(ShardResult<TypeParam>::merge(shards), std::invalid_argument);
+    shards.push_back(shards.front());
+    EXPECT_THROW(ShardResult<TypeParam>::merge(shards), std::invalid_argument);
+
+    // A corrupt shard count is rejected before anything is sized by it
+    for (auto& shard : shards) {
+        shard.shardCount = uint64_t{1} << 60;
+    }
+    EXPECT_THROW(ShardResult<TypeParam>::merge(shards), std::invalid_argument);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,79 @@
+#include "utils/thread_pool.h"
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace Subgraphs;
+
+TEST(ThreadPoolTest, SubmitReturnsResults) {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.size(), 3);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 20; ++i) {
+        futures.push_back(pool.submit([i] { return i * i; }));
+    }
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(futures[i].get(), i * i);
+    }
+}
+
+TEST(ThreadPoolTest, ZeroThreadsFallsBackToOne) {
+    ThreadPool pool(0);
+    EXPECT_EQ(pool.size(), 1);
+    EXPECT_EQ(pool.submit([] { return 7; }).get(), 7);
+}
+
+TEST(ThreadPoolTest, SubmitPropagatesExceptions) {
+    ThreadPool pool(2);
+    auto future = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ParallelForCoversRangeExactlyOnce) {
+    ThreadPool pool(4);
+    std::vector<int> visits(1000, 0);
+
+    pool.parallelFor(visits.size(), 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ++visits[i];
+        }
+    });
+
+    for (int count : visits) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(ThreadPoolTest, ParallelForHandlesSmallAndEmptyRanges) {
+    ThreadPool pool(4);
+    std::atomic<size_t> total{0};
+
+    pool.parallelFor(0, 8, [&](size_t begin, size_t end) { total += end - begin; });
+    EXPECT_EQ(total.load(), 0);
+
+    pool.parallelFor(3, 8, [&](size_t begin, size_t end) { total += end - begin; });
+    EXPECT_EQ(total.load(), 3);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsAfterAllChunksFinish) {
+    ThreadPool pool(2);
+    std::atomic<int> finished{0};
+
+    EXPECT_THROW(pool.parallelFor(8, 8,
+                                  [&](size_t begin, size_t) {
+                                      if (begin == 0) {
+                                          throw std::runtime_error("chunk failed");
+                                      }
+                                      ++finished;
+                                  }),
+                 std::runtime_error);
+    EXPECT_EQ(finished.load(), 7);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include "algorithms/subgraph_algorithm.h"
+#include "graph/multigraph.h"
+#include "utils/thread_pool.h"
+#include "utils/trace.h"
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace Subgraphs;
+
+class TraceTest : public ::testing::Test {
+  protected:
+    void SetUp() override { Trace::reset(); }
+    void TearDown() override { Trace::reset(); }
+
+    static std::string json() {
+        std::ostringstream out;
+        Trace::write(out);
+        return out.str();
+    }
+
+    static size_t count(const std::string& text, const std::string& needle) {
+        size_t occurrences = 0;
+        for (size_t at = text.find(needle); at != std::string::npos;
+             at = text.find(needle, at + needle.size())) {
+            ++occurrences;
+        }
+        return occurrences;
+    }
+};
+
+TEST_F(TraceTest, DisabledSpansRecordNothing) {
+    EXPECT_FALSE(Trace::enabled());
+    { TraceSpan span("ignored"); }
+    EXPECT_EQ(count(json(), "\"ph\":\"X\""), 0u);
+}
+
+TEST_F(TraceTest, SpanBecomesCompleteEvent) {
+    Trace::enable();
+    { TraceSpan span("phase", "test", "k", 4); }
+
+    const std::string trace = json();
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(count(trace, "\"ph\":\"X\""), 1u);
+    EXPECT_NE(trace.find("\"name\":\"phase\",\"cat\":\"test\""), std::string::npos);
+    EXPECT_NE(trace.find("\"args\":{\"k\":4}"), std::string::npos);
+    EXPECT_NE(trace.find("\"args\":{\"name\":\"main\"}"), std::string::npos);
+}
+
+TEST_F(TraceTest, ThreadsGetTheirOwnTimeline) {
+    Trace::enable();
+    { TraceSpan span("on main"); }
+    ThreadPool pool(2);
+    pool.submit([] { TraceSpan span("on worker"); }).get();
+
+    const std::string trace = json();
+    EXPECT_EQ(count(trace, "\"ph\":\"M\""), 2u);
+    EXPECT_NE(trace.find("\"name\":\"on main\",\"cat\":\"solver\",\"ph\":\"X\",\"pid\":1,\"tid\":1"),
+              std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"on worker\",\"cat\":\"solver\",\"ph\":\"X\",\"pid\":1,\"tid\":2"),
+              std::string::npos);
+}
+
+TEST_F(TraceTest, ResetDropsEvents) {
+    Trace::enable();
+    { TraceSpan span("before reset"); }
+    Trace::reset();
+    EXPECT_FALSE(Trace::enabled());
+    Trace::enable();
+    { TraceSpan span("after reset"); }
+
+    const std::string trace = json();
+    EXPECT_EQ(trace.find("before reset"), std::string::npos);
+    EXPECT_NE(trace.find("after reset"), std::string::npos);
+}
+
+TEST_F(TraceTest, SolverPhasesAreTraced) {
+    Multigraph<int32_t> P(std::vector<std::vector<uint8_t>>{{0, 1, 0}, {0, 0, 1}, {1, 0, 0}});
+    Multigraph<int32_t> G(std::vector<std::vector<uint8_t>>{
+        {0, 1, 0, 0, 1}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 0}, {1, 0, 0, 0, 1}, {0, 1, 0, 0, 0}});
+
+    Trace::enable();
+    SubgraphAlgorithm<int32_t>::run(2, P, G);
+    SubgraphAlgorithm<int32_t>::run_approx_v2(2, P, G);
+
+    const std::string trace = json();
+    for (const char* name : {"getAllMissingEdges", "findMinimalExtension", "search chunk",
+                             "createWeightMatrix", "HungarianAlgorithm::Solve"}) {
+        EXPECT_NE(trace.find("\"name\":\"" + std::string(name) + "\""), std::string::npos)
+            << name;
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}